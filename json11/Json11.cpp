@@ -1,31 +1,107 @@
 #include "Json11.h"
+#include "JsonMappedFile.h"
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <thread>
 
 namespace json11 {
 
-Json::Json() noexcept							: m_ptr(json11::default_null) {}
-Json::Json(std::nullptr_t) noexcept				: m_ptr(json11::default_null) {}
-Json::Json(bool value)							: m_ptr(value ? json11::default_true : json11::default_false) {}
-Json::Json(int value)							: m_ptr(std::make_shared<NumberValue>(value)) {}
-Json::Json(double value)						: m_ptr(std::make_shared<NumberValue>(value)) {}
-Json::Json(const std::string& value)			: m_ptr(std::make_shared<StringValue>(value)) {}
-Json::Json(std::string&& value)					: m_ptr(std::make_shared<StringValue>(move(value))) {}
-Json::Json(const char* value)					: m_ptr(std::make_shared<StringValue>(value)) {}
-Json::Json(const json11::JsonArray& value)		: m_ptr(std::make_shared<ArrayValue>(value)) {}
-Json::Json(json11::JsonArray&& value)			: m_ptr(std::make_shared<ArrayValue>(move(value))) {}
-Json::Json(const json11::JsonObject& value)		: m_ptr(std::make_shared<ObjectValue>(value)) {}
-Json::Json(json11::JsonObject&& value)			: m_ptr(std::make_shared<ObjectValue>(move(value))) {}
+Json::Json() noexcept							: m_data{} {}
+Json::Json(std::nullptr_t) noexcept				: m_data{} {}
+Json::Json(bool value)							: m_data{} { m_data.scalar.storage = Storage::BOOL; m_data.scalar.value.boolean = value; }
+Json::Json(double value)						: m_data{} { m_data.scalar.storage = Storage::DOUBLE; m_data.scalar.value.number = value; }
+Json::Json(const std::string& value)			: Json(std::string_view(value)) {}
+Json::Json(std::string&& value)					: Json(value.size() <= short_string_capacity ? make_short(value) : make<StringValue>(nullptr, std::move(value))) {}
+Json::Json(const char* value)					: Json(std::string_view(value)) {}
+Json::Json(std::string_view value)				: Json(value.size() <= short_string_capacity ? make_short(value) : make<StringValue>(nullptr, std::string(value))) {}
+Json::Json(const json11::JsonArray& value)		: Json(make<ArrayValue>(nullptr, value)) {}
+Json::Json(json11::JsonArray&& value)			: Json(make<ArrayValue>(nullptr, std::move(value))) {}
+Json::Json(const json11::JsonObject& value)		: Json(make<ObjectValue>(nullptr, value)) {}
+Json::Json(json11::JsonObject&& value)			: Json(make<ObjectValue>(nullptr, std::move(value))) {}
 
+static_assert(sizeof(Json) == 16, "JsonӦǡռ16ֽ");
 
+Json Json::make_short(std::string_view value) {
+	Json result;
+	result.m_data.short_string = ShortString{ Storage::SHORT_STRING, static_cast<uint8_t>(value.size()), {} };
+	std::memcpy(result.m_data.short_string.chars, value.data(), value.size());
+	return result;
+}
+
+/* operator==operator<
+ *
+ * ͲͬʱJsonType˳Ƚϣ֮䰴ֵȽϣ븡ȣ顢ȽеԪ
+ * ְȷֵȽϣcompare_number()2^53ΪתΪdoubleڵ
+ * ָͬһڵJsonһȣֻߵĴ洢ͬǽڵ㣩ʱűȽָ룬ַݵָȡ
+ */
 bool Json::operator== (const Json& rhs) const {
-	if (m_ptr == rhs.m_ptr) return false;
-	if (m_ptr->type() != rhs.m_ptr->type()) return false;
-	return m_ptr->equals(rhs.m_ptr.get());
+	if (has_node() && storage() == rhs.storage() && node() == rhs.node()) return true;
+	const json11::JsonType t = type();
+	if (t != rhs.type()) return false;
+	switch (t) {
+	case NUL:		return true;
+	case BOOL:		return m_data.scalar.value.boolean == rhs.m_data.scalar.value.boolean;
+	case NUMBER:	return compare_number(rhs) == 0;
+	case STRING:	return string_view_value() == rhs.string_view_value();
+	case ARRAY:		return array_items() == rhs.array_items();
+	case OBJECT:	return object_items() == rhs.object_items();
+	}
+	return false;
 }
 bool Json::operator<  (const Json& rhs) const {
-	if (m_ptr == rhs.m_ptr) return false;
-	if (m_ptr->type() != rhs.m_ptr->type()) return m_ptr->type() < rhs.m_ptr->type();
-	return m_ptr->less(rhs.m_ptr.get());
+	if (has_node() && storage() == rhs.storage() && node() == rhs.node()) return false;
+	const json11::JsonType t = type();
+	if (t != rhs.type()) return t < rhs.type();
+	switch (t) {
+	case NUL:		return false;
+	case BOOL:		return m_data.scalar.value.boolean < rhs.m_data.scalar.value.boolean;
+	case NUMBER:	return compare_number(rhs) < 0;
+	case STRING:	return string_view_value() < rhs.string_view_value();
+	case ARRAY:		return array_items() < rhs.array_items();
+	case OBJECT:	return object_items() < rhs.object_items();
+	}
+	return false;
 }
+/* compare_integer()
+ *
+ * ȷȽvalue븡numbernumberTķΧʱֱӵõ
+ * ȱȽnumber֣TȷʾʱС־
+ */
+template <typename T>
+static std::partial_ordering compare_integer(T value, double number) {
+	// ߽綼2ݣdoubleȷʾ
+	constexpr double lower = std::is_signed_v<T> ? -9223372036854775808.0 : 0.0;
+	constexpr double upper = std::is_signed_v<T> ? 9223372036854775808.0 : 18446744073709551616.0;
+	if (std::isnan(number)) return std::partial_ordering::unordered;
+	if (number < lower) return std::partial_ordering::greater;
+	if (number >= upper) return std::partial_ordering::less;
+	const double whole = std::trunc(number);
+	const T integral = static_cast<T>(whole);
+	if (value != integral) return value <=> integral;
+	return 0.0 <=> number - whole;
+}
+
+/* compare_number()
+ *
+ * doubleȽϣֱӱȽϣUINTֻ泬INT64_MAXֵһκINT
+ * 븡compare_integer()ȽϣתΪdouble˱ȽϽ㴫ԣΪļ
+ */
+std::partial_ordering Json::compare_number(const Json& rhs) const {
+	const Payload& lhs_value = m_data.scalar.value;
+	const Payload& rhs_value = rhs.m_data.scalar.value;
+	const Storage lhs_storage = storage();
+	const Storage rhs_storage = rhs.storage();
+	if (lhs_storage == Storage::DOUBLE && rhs_storage == Storage::DOUBLE) return lhs_value.number <=> rhs_value.number;
+	if (lhs_storage == Storage::DOUBLE) return 0 <=> rhs.compare_number(*this);
+	if (rhs_storage == Storage::DOUBLE) {
+		return lhs_storage == Storage::INT ? compare_integer(lhs_value.integer, rhs_value.number)
+										   : compare_integer(lhs_value.uinteger, rhs_value.number);
+	}
+	if (lhs_storage != rhs_storage) return lhs_storage == Storage::INT ? std::partial_ordering::less : std::partial_ordering::greater;
+	return lhs_storage == Storage::INT ? lhs_value.integer <=> rhs_value.integer : lhs_value.uinteger <=> rhs_value.uinteger;
+}
+
 bool Json::operator!= (const Json& rhs) const {
 	return !(*this == rhs);
 }
@@ -39,29 +115,114 @@ bool Json::operator>= (const Json& rhs) const {
 	return !(*this < rhs);
 }
 
-json11::JsonType			Json::type() const			{ return m_ptr->type(); }
-bool						Json::bool_value() const	{ return m_ptr->bool_value(); }
-int							Json::int_value() const		{ return m_ptr->int_value(); }
-double						Json::number_value() const	{ return m_ptr->number_value(); }
-const std::string&			Json::string_value() const	{ return m_ptr->string_value(); }
-const JsonArray& Json::array_items() const { return m_ptr->array_items(); }
-const JsonObject& Json::object_items() const { return m_ptr->object_items(); }
+/*
+ * ·ʽӿھstorage()ֱӷɣͲʱĬֵJsonValue.hеstatic ʼճԱ
+ */
+json11::JsonType Json::type() const {
+	switch (storage()) {
+	case Storage::NUL:			return NUL;
+	case Storage::BOOL:			return BOOL;
+	case Storage::INT:
+	case Storage::UINT:
+	case Storage::DOUBLE:		return NUMBER;
+	case Storage::SHORT_STRING:
+	case Storage::STRING:
+	case Storage::STRING_REF:	return STRING;
+	case Storage::ARRAY:		return ARRAY;
+	case Storage::OBJECT:		return OBJECT;
+	}
+	return NUL;
+}
+bool Json::bool_value() const {
+	return storage() == Storage::BOOL && m_data.scalar.value.boolean;
+}
+int Json::int_value() const {
+	if (storage() == Storage::INT) return static_cast<int>(m_data.scalar.value.integer);
+	if (storage() == Storage::UINT) return static_cast<int>(m_data.scalar.value.uinteger);
+	if (storage() == Storage::DOUBLE) return static_cast<int>(m_data.scalar.value.number);
+	return 0;
+}
+int64_t Json::int64_value() const {
+	switch (storage()) {
+	case Storage::INT:		return m_data.scalar.value.integer;
+	case Storage::UINT:		return INT64_MAX;
+	case Storage::DOUBLE: {
+		// 2^63doubleȷʾСֵint64_tķΧ
+		const double value = m_data.scalar.value.number;
+		if (std::isnan(value)) return 0;
+		if (value >= 9223372036854775808.0) return INT64_MAX;
+		if (value <= -9223372036854775808.0) return INT64_MIN;
+		return static_cast<int64_t>(value);
+	}
+	default:				return 0;
+	}
+}
+uint64_t Json::uint64_value() const {
+	switch (storage()) {
+	case Storage::INT:		return m_data.scalar.value.integer < 0 ? 0 : static_cast<uint64_t>(m_data.scalar.value.integer);
+	case Storage::UINT:		return m_data.scalar.value.uinteger;
+	case Storage::DOUBLE: {
+		const double value = m_data.scalar.value.number;
+		if (std::isnan(value) || value <= 0) return 0;
+		if (value >= 18446744073709551616.0) return UINT64_MAX;
+		return static_cast<uint64_t>(value);
+	}
+	default:				return 0;
+	}
+}
+double Json::number_value() const {
+	if (storage() == Storage::INT) return static_cast<double>(m_data.scalar.value.integer);
+	if (storage() == Storage::UINT) return static_cast<double>(m_data.scalar.value.uinteger);
+	if (storage() == Storage::DOUBLE) return m_data.scalar.value.number;
+	return 0;
+}
+std::string Json::string_value() const {
+	return std::string(string_view_value());
+}
+std::string_view Json::string_view_value() const {
+	switch (storage()) {
+	case Storage::SHORT_STRING:	return std::string_view(m_data.short_string.chars, m_data.short_string.size);
+	case Storage::STRING:		return static_cast<const StringValue*>(node())->m_value;
+	case Storage::STRING_REF:	return static_cast<const StringRefValue*>(node())->m_view;
+	default:					return std::string_view();
+	}
+}
+const JsonArray& Json::array_items() const {
+	if (storage() == Storage::ARRAY) return static_cast<const ArrayValue*>(node())->m_value;
+	return json11::default_array;
+}
+const JsonObject& Json::object_items() const {
+	if (storage() == Storage::OBJECT) return static_cast<const ObjectValue*>(node())->m_value;
+	return json11::default_object;
+}
 
-// ˾̬Jsonڰʵ
-static Json static_json;
 /* operator[size_t i]
  * 
+ * еԪرJsonֱӷãiԽʱnull
  */
 const Json& Json::operator[] (size_t i) const {
-	static_json.m_ptr = (*m_ptr)[i];
-	return static_json;
+	if (storage() != Storage::ARRAY) return json11::default_null;
+	return (*static_cast<const ArrayValue*>(node()))[i];
 }
-/* operator[const string& key]
+/* operator[string_view key]
  *
+ * ضkeyӦֵǶkeyʱnull
  */
-const Json& Json::operator[](const std::string& key) const {
-	static_json.m_ptr = (*m_ptr)[key]; 
-	return static_json;
+const Json& Json::operator[](std::string_view key) const {
+	if (storage() != Storage::OBJECT) return json11::default_null;
+	return (*static_cast<const ObjectValue*>(node()))[key];
+}
+const Json& Json::operator[](const JsonKey& key) const {
+	if (storage() != Storage::OBJECT) return json11::default_null;
+	return (*static_cast<const ObjectValue*>(node()))[key];
+}
+/* get(const ObjectKey& key)
+ *
+ * keyJsonKeyTable::intern()ԤȵõINTERN_KEYSģʽĵвʱȱȽָ
+ */
+const Json& Json::get(const ObjectKey& key) const {
+	if (storage() != Storage::OBJECT) return json11::default_null;
+	return static_cast<const ObjectValue*>(node())->get(key);
 }
 
 bool Json::is_null()   const { return type() == NUL; }
@@ -79,7 +240,7 @@ bool Json::has_shape(const json11::shape& types, std::string& err) const {
 	const auto& obj_items = object_items();
 	for (auto& item : types) {
 		const auto it = obj_items.find(item.first);
-		if (it == obj_items.cend() || (*it->second).type() != item.second) {
+		if (it == obj_items.cend() || it->second.type() != item.second) {
 			err = "bad type for " + item.first + " in " + dump();
 			return false;
 		}
@@ -89,8 +250,50 @@ bool Json::has_shape(const json11::shape& types, std::string& err) const {
 }
 
 
+/* dump()
+ *
+ * ǰJsonеݸתΪstringʽӵòoutβ
+ * ֱӰʮ17λЧ֣޵ĸΪnull
+ */
 void Json::dump(std::string& out) const {
-	m_ptr->dump(out);
+	switch (storage()) {
+	case Storage::NUL:
+		out += "null";
+		break;
+	case Storage::BOOL:
+		out += m_data.scalar.value.boolean ? "true" : "false";
+		break;
+	case Storage::INT: {
+		char buf[24];
+		out.append(buf, std::to_chars(buf, buf + sizeof buf, m_data.scalar.value.integer).ptr);
+		break;
+	}
+	case Storage::UINT: {
+		char buf[24];
+		out.append(buf, std::to_chars(buf, buf + sizeof buf, m_data.scalar.value.uinteger).ptr);
+		break;
+	}
+	case Storage::DOUBLE:
+		if (std::isfinite(m_data.scalar.value.number)) {
+			char buf[32];
+			snprintf(buf, sizeof buf, "%.17g", m_data.scalar.value.number);
+			out += buf;
+		} else {
+			out += "null";
+		}
+		break;
+	case Storage::SHORT_STRING:
+	case Storage::STRING:
+	case Storage::STRING_REF:
+		dump_string(string_view_value(), out);
+		break;
+	case Storage::ARRAY:
+		static_cast<const ArrayValue*>(node())->dump(out);
+		break;
+	case Storage::OBJECT:
+		static_cast<const ObjectValue*>(node())->dump(out);
+		break;
+	}
 }
 
 std::string Json::dump() const {
@@ -99,31 +302,260 @@ std::string Json::dump() const {
 	return out;
 }
 
-Json Json::parse(const std::string& in, std::string& err) {
-	JsonParser parser(in, err);
-	Json result;
-	result.m_ptr = parser.parse();
+/* parse()
+ *
+ * std::string& err汾ĽӿھJsonError汾ʵֻ֣ڷʱɴϢ
+ * ûдĵĽӿڴӵǰ̵߳ĳнһJsonParserContext
+ */
+Json Json::parse(std::string_view in, JsonError& error, JsonParseMode mode, int max_depth) {
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	return parse(in, *context, error, mode, max_depth);
+}
+
+Json Json::parse(std::string_view in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse(in, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+/* parse(string&& in)
+ *
+ * IN_SITUģʽinƶһ鹲ĻУɽеStringRefValueͬУ
+ */
+Json Json::parse(std::string&& in, JsonError& error, JsonParseMode mode, int max_depth) {
+	if (!(mode & IN_SITU)) return parse(std::string_view(in), error, mode, max_depth);
+	const std::shared_ptr<const std::string> buffer = std::make_shared<const std::string>(std::move(in));
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(*buffer, error, mode, max_depth, buffer, &*context);
+	return parser.parse();
+}
+
+Json Json::parse(std::string&& in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse(std::move(in), error, mode, max_depth);
+	if (error) err += error.message();
 	return result;
 }
 
-Json Json::parse(const char* in, std::string& err) {
+Json Json::parse(const char* in, JsonError& error, JsonParseMode mode, int max_depth) {
 	if (in) {
-		return parse(std::string(in), err);
+		return parse(std::string_view(in), error, mode, max_depth);
 	} else {
-		err = "null input";
+		error.set(ERR_NULL_INPUT, std::string_view(), 0);
 		return nullptr;
 	}
 }
 
-std::vector<Json> Json::parse_multi(const std::string& in, std::string& err) {
-	JsonParser parser(in, err);
-	json11::JsonArray arrays = parser.parse_multi();
+Json Json::parse(const char* in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse(in, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
 
-	std::vector<Json> result(arrays.size(), Json());
-	for (size_t i = 0; i < arrays.size(); ++i) {
-		result[i].m_ptr = arrays[i];
+Json Json::parse(std::string_view in, JsonParserContext& context, JsonError& error, JsonParseMode mode, int max_depth) {
+	// IN_SITUģʽĵҪ룬inڵߣֻȸһ
+	const std::shared_ptr<const std::string> buffer = mode & IN_SITU ? std::make_shared<const std::string>(in) : nullptr;
+	JsonParser parser(buffer ? std::string_view(*buffer) : in, error, mode, max_depth, buffer, &context);
+	return parser.parse();
+}
+
+Json Json::parse(std::string_view in, JsonParserContext& context, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse(in, context, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+/* parse(filter)
+ *
+ * IN_SITUģʽparse()ͬȽinƵһ鹲Ļ
+ */
+Json Json::parse(std::string_view in, const JsonPathFilter& filter, JsonError& error, JsonParseMode mode, int max_depth) {
+	const std::shared_ptr<const std::string> buffer = mode & IN_SITU ? std::make_shared<const std::string>(in) : nullptr;
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(buffer ? std::string_view(*buffer) : in, error, mode, max_depth, buffer, &*context);
+	return parser.parse(filter);
+}
+
+Json Json::parse(std::string_view in, const JsonPathFilter& filter, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse(in, filter, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+/* parse_file()
+ *
+ * IN_SITUģʽ£ӳڽɺͷţIN_SITUģʽɽͬ
+ */
+Json Json::parse_file(const std::string& path, JsonError& error, JsonParseMode mode, int max_depth) {
+	const std::shared_ptr<const JsonMappedFile> file = JsonMappedFile::open(path, error);
+	if (!file) return nullptr;
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(file->view(), error, mode, max_depth, file, &*context);
+	return parser.parse();
+}
+
+Json Json::parse_file(const std::string& path, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse_file(path, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+/* validate()
+ *
+ * parse()JsonParser﷨Jsonת֮ǰܾǷ
+ */
+bool Json::validate(std::string_view in, JsonError& error, int max_depth) {
+	JsonParser parser(in, error, STANDARD, max_depth);
+	return parser.validate();
+}
+
+bool Json::validate(std::string_view in, std::string& err, int max_depth) {
+	JsonError error;
+	const bool ok = validate(in, error, max_depth);
+	if (!ok) err += error.message();
+	return ok;
+}
+
+std::vector<Json> Json::parse_multi(std::string_view in, JsonError& error, JsonParseMode mode, int max_depth) {
+	if (mode & IN_SITU) return parse_multi(std::string(in), error, mode, max_depth);
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(in, error, mode, max_depth, nullptr, &*context);
+	return parser.parse_multi();
+}
+
+std::vector<Json> Json::parse_multi(std::string_view in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	std::vector<Json> result = parse_multi(in, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+std::vector<Json> Json::parse_multi(std::string&& in, JsonError& error, JsonParseMode mode, int max_depth) {
+	if (!(mode & IN_SITU)) return parse_multi(std::string_view(in), error, mode, max_depth);
+	const std::shared_ptr<const std::string> buffer = std::make_shared<const std::string>(std::move(in));
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(*buffer, error, mode, max_depth, buffer, &*context);
+	return parser.parse_multi();
+}
+
+std::vector<Json> Json::parse_multi(std::string&& in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	std::vector<Json> result = parse_multi(std::move(in), error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+/* parse_chunks()
+ *
+ * parse_multi_parallel()ʵ
+ * 1. in¾ΪɶΣÿεΪĳз֮ĵһǿհַ
+ *    ÿһĵ루NDJSONһĳĵĿͷ
+ * 2. ̴߳ӹļȡκţJsonParser::parse_multi(stop)һΣ
+ *    һĵԽεյ㣬ͬʱ¼ʵͣµλ
+ * 3. ˳ϲһǡͣڱʱεĽ˳ȫֱͬӲã
+ *    ˵ֶεĳĵڲеĵδһͣµλ˳
+ *    һĶʱֹ֮ͣεĽȫ
+ *    ζinϽƫк˳һ
+ */
+static std::vector<Json> parse_chunks(std::string_view in, JsonError& error, unsigned threads,
+									  JsonParseMode mode, int max_depth, const std::shared_ptr<const void>& owner) {
+	static constexpr size_t min_chunk_size = 1 << 20; // ÿ1MB̫СĶβֵý߳
+	static constexpr size_t chunks_per_thread = 4; // ÿ߳ƽֵĶ߳ʱظ
+
+	if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+	const size_t chunk_count = std::min<size_t>(threads * chunks_per_thread, in.size() / min_chunk_size + 1);
+
+	std::vector<size_t> starts{ 0 };
+	for (size_t k = 1; k < chunk_count; ++k) {
+		size_t pos = in.find('\n', std::max(k * (in.size() / chunk_count), starts.back()));
+		if (pos != std::string::npos) pos = in.find_first_not_of(" \t\r\n", pos);
+		if (pos == std::string::npos) break;
+		if (pos > starts.back()) starts.push_back(pos);
+	}
+	starts.push_back(in.size());
+
+	struct Chunk {
+		json11::JsonArray values;
+		JsonError error;
+		size_t end = 0; // ʵͣµλ
+		bool failed = false;
+	};
+	std::vector<Chunk> chunks(starts.size() - 1);
+	auto parse_chunk = [&](size_t k, size_t begin) {
+		Chunk& chunk = chunks[k];
+		chunk.error = JsonError();
+		const JsonParserContext::Lease context = JsonParserContext::local();
+		JsonParser parser(in, begin, chunk.error, mode, max_depth, owner, &*context);
+		chunk.values = parser.parse_multi(starts[k + 1]);
+		chunk.end = parser.position();
+		chunk.failed = parser.failed();
+	};
+
+	std::atomic<size_t> next_chunk{ 0 };
+	auto worker = [&]() {
+		for (size_t k = next_chunk++; k < chunks.size(); k = next_chunk++) {
+			parse_chunk(k, starts[k]);
+		}
+	};
+	std::vector<std::thread> pool;
+	for (unsigned t = 1; t < threads && t < chunks.size(); ++t) {
+		pool.emplace_back(worker);
 	}
+	worker();
+	for (std::thread& t : pool) t.join();
+
+	std::vector<Json> result;
+	size_t pos = 0;
+	for (size_t k = 0; k < chunks.size(); ++k) {
+		if (pos != starts[k]) {
+			// һεһĵԽ˱ε㣬Ҫposʼ½
+			if (pos >= starts[k + 1]) continue;
+			parse_chunk(k, pos);
+		}
+		Chunk& chunk = chunks[k];
+		for (Json& value : chunk.values) {
+			result.push_back(std::move(value));
+		}
+		pos = chunk.end;
+		if (chunk.failed) {
+			error = chunk.error;
+			break;
+		}
+	}
+	return result;
+}
+
+std::vector<Json> Json::parse_multi_parallel(std::string_view in, JsonError& error, unsigned threads,
+											 JsonParseMode mode, int max_depth) {
+	if (mode & IN_SITU) return parse_multi_parallel(std::string(in), error, threads, mode, max_depth);
+	return parse_chunks(in, error, threads, mode, max_depth, nullptr);
+}
+
+std::vector<Json> Json::parse_multi_parallel(std::string_view in, std::string& err, unsigned threads,
+											 JsonParseMode mode, int max_depth) {
+	JsonError error;
+	std::vector<Json> result = parse_multi_parallel(in, error, threads, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+std::vector<Json> Json::parse_multi_parallel(std::string&& in, JsonError& error, unsigned threads,
+											 JsonParseMode mode, int max_depth) {
+	if (!(mode & IN_SITU)) return parse_multi_parallel(std::string_view(in), error, threads, mode, max_depth);
+	const std::shared_ptr<const std::string> buffer = std::make_shared<const std::string>(std::move(in));
+	return parse_chunks(*buffer, error, threads, mode, max_depth, buffer);
+}
 
+std::vector<Json> Json::parse_multi_parallel(std::string&& in, std::string& err, unsigned threads,
+											 JsonParseMode mode, int max_depth) {
+	JsonError error;
+	std::vector<Json> result = parse_multi_parallel(std::move(in), error, threads, mode, max_depth);
+	if (error) err += error.message();
 	return result;
 }
 };
\ No newline at end of file
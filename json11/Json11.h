@@ -1,10 +1,84 @@
 #pragma once
-#include "JsonParser.cpp"
+#include "json11_namespace.h"
+#include "JsonError.h"
+#include "JsonPathFilter.h"
+#include <compare>
+#include <cstdint>
+#include <type_traits>
 
 namespace json11 {
+class JsonArena;
+class JsonKey;
+class JsonNode;
+class StringValue;
+class StringRefValue;
+class ArrayValue;
+class ObjectValue;
+class JsonParserContext;
+template <typename Policy>
+class BasicJsonParser;
+
+/* Json
+ *
+ * JsonеһֵС̶Ϊ16ֽڣ1ֽڵĴ洢ͼ
+ * nullboolint64_tuint64_tȷ棩Լshort_string_capacityֽڵĶֱַӱJsonڲڴ棻
+ * ַԼ顢󱣴ڶϵĽڵУJsonValue.hJsonָֻ
+ * ڵüJsonʱԭJsonͬһڵ㣬ڵ㹹󲻻ᱻ޸ģ˿Ա߳ͬʱȡ
+ * зʽӿڶݴ洢ֱӷɣҪ麯
+ */
 class Json final {
 public:
-	std::shared_ptr<JsonValue> m_ptr;
+	static constexpr size_t short_string_capacity = 14;
+private:
+	// Storage ΪݵĴ洢ʽJsonTypeϸַΪ븡ַΪַе뻺ģIN_SITU
+	// Ϊint64_tINTֻгINT64_MAXķǸűΪuint64_tUINTͬһֻһִ洢ʽ
+	// STRING֮Ĵ洢ͶָһJsonNode
+	enum class Storage : uint8_t {
+		NUL, BOOL, INT, UINT, DOUBLE, SHORT_STRING, STRING, STRING_REF, ARRAY, OBJECT
+	};
+	union Payload {
+		bool boolean;
+		int64_t integer;
+		uint64_t uinteger;
+		double number;
+		JsonNode* node;
+	};
+	// ScalarShortString ΪJsonֲ֣ͷǴ洢ͣʼУֲЧͨscalar.storageȡ
+	struct Scalar {
+		Storage storage;
+		Payload value;
+	};
+	struct ShortString {
+		Storage storage;
+		uint8_t size;
+		char chars[short_string_capacity];
+	};
+	union Data {
+		Scalar scalar;
+		ShortString short_string;
+	};
+	Data m_data;
+
+	friend class StringValue;
+	friend class StringRefValue;
+	friend class ArrayValue;
+	friend class ObjectValue;
+
+	Storage storage() const { return m_data.scalar.storage; }
+	JsonNode* node() const { return m_data.scalar.value.node; }
+	// make_short() ڴֱӱJsonڲĶַvalueĳȲܳshort_string_capacity
+	static Json make_short(std::string_view value);
+	bool has_node() const { return storage() >= Storage::STRING; }
+	// compare_number() ھȷȽ֣һΪNaNʱunordered
+	std::partial_ordering compare_number(const Json& rhs) const;
+	// destroy() һָڵJsonʱͷŽڵ
+	void destroy() noexcept;
+	// is_unique_container() жϵǰJsonǷΪֻԼе顢ڵ
+	bool is_unique_container() const;
+	// release_children() ڽֻǰڵе顢ӽڵƶoutУֻͷ顢ڵʱʹ
+	void release_children(json11::JsonArray& out);
+	// release_all() ͷpendingеĽڵ㣬ͷǰȡӽڵ㣬ʹǶ׵ݲݹ
+	static void release_all(json11::JsonArray& pending);
 public:
 	/*
 	 * JsonĹ캯
@@ -12,11 +86,14 @@ public:
 	Json() noexcept;
 	Json(std::nullptr_t) noexcept;
 	Json(bool value);
-	Json(int value);
+	// bool⣩ȷ棬double
+	template <typename T> requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	Json(T value) noexcept;
 	Json(double value);
 	Json(const std::string& value);
 	Json(std::string&& value);
 	Json(const char* value);
+	Json(std::string_view value);
 	Json(const JsonArray& value);
 	Json(JsonArray&& value);
 	Json(const JsonObject& value);
@@ -24,6 +101,26 @@ public:
 
 	Json(void*) = delete;
 
+	// ҪʽڵüJsonValue.h
+	Json(const Json& other) noexcept;
+	Json(Json&& other) noexcept : m_data(other.m_data) { other.m_data.scalar.storage = Storage::NUL; }
+	Json& operator= (const Json& rhs) noexcept {
+		Json(rhs).swap(*this);
+		return *this;
+	}
+	Json& operator= (Json&& rhs) noexcept {
+		Json(std::move(rhs)).swap(*this);
+		return *this;
+	}
+	~Json();
+	void swap(Json& other) noexcept {
+		std::swap(m_data, other.m_data);
+	}
+
+	// make<V>() һVͣStringValueStringRefValueArrayValueObjectValueĽڵ㣬JsonParserͨarenaзڵ
+	template <typename V, typename... Args>
+	static Json make(const std::shared_ptr<JsonArena>& arena, Args&&... args);
+
 	/*
 	 *  JsonĲ
 	 */
@@ -36,11 +133,86 @@ public:
 
 	/*
 	 *  ΪһЩҪĽӿ
+	 *  max_depthǶײΣʹõݹ飬˿԰
+	 *  std::string_view룬std::stringconst char*Լһ(ָ, )ڴ涼ֱԭᱻ
+	 *  ֻIN_SITUģʽ£ĵҪ룬ʱֵᱻһݣ
+	 *  ÿӿڶ汾JsonError汾ֻ¼λãڴ棬ʺҪܾǷĳ
+	 *  std::string& err汾ڳʱJsonError::message()׷ӵerrβ
+	 */
+	static Json parse(std::string_view in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(std::string&& in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(const char* in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(std::string_view in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(std::string&& in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(const char* in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+
+	/* parse(context)
+	 *
+	 * ʹõṩJsonParserContextͬһĵʱظݴռ䣨JsonParserContext.h
+	 * contextĽӿʹJsonParserContext::local()ǰ̵߳ĳأҪĵڻڴռʱʹһӿ
+	 */
+	static Json parse(std::string_view in, JsonParserContext& context, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(std::string_view in, JsonParserContext& context, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+
+	// filterparse()ֻfilter·ѡеֵֵڽʱֱڴ棬JsonPathFilter
+	static Json parse(std::string_view in, const JsonPathFilter& filter, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse(std::string_view in, const JsonPathFilter& filter, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+
+	// parse_file() pathӦļӳ䵽ڴֱӽὫļstringIN_SITUģʽ½еֱַӳ
+	static Json parse_file(const std::string& path, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static Json parse_file(const std::string& path, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+
+	static std::vector<Json> parse_multi(std::string_view in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi(std::string&& in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi(std::string_view in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi(std::string&& in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	// parse_multi_parallel() ڻдֶΣthreads̲߳нthreadsΪ0ʱʹӲ߳parse_multi()ȫͬ
+	static std::vector<Json> parse_multi_parallel(std::string_view in, JsonError& error, unsigned threads = 0,
+												  JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi_parallel(std::string&& in, JsonError& error, unsigned threads = 0,
+												  JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi_parallel(std::string_view in, std::string& err, unsigned threads = 0,
+												  JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+	static std::vector<Json> parse_multi_parallel(std::string&& in, std::string& err, unsigned threads = 0,
+												  JsonParseMode mode = STANDARD, int max_depth = default_max_depth);
+
+	// validate() ֻinǷΪϷJson﷨parse()ͬҪַΪϷUTF-8κֵҲڴ
+	static bool validate(std::string_view in, JsonError& error, int max_depth = default_max_depth);
+	static bool validate(std::string_view in, std::string& err, int max_depth = default_max_depth);
+
+	/* parse_sax()
+	 *
+	 * JsonǽֵνhandlerHandlerĽӿڼJsonParser::parse_sax()
+	 * HandlerΪģӿڵĵÿԱ
 	 */
-	static Json parse(const std::string& in, std::string& err);
-	static Json parse(const char* in, std::string& err);
+	template <typename Handler>
+	static bool parse_sax(std::string_view in, Handler& handler, JsonError& error, int max_depth = default_max_depth);
+
+	template <typename Handler>
+	static bool parse_sax(std::string_view in, Handler& handler, std::string& err, int max_depth = default_max_depth);
+
+	/* parse<Policy>()validate<Policy>()parse_sax<Policy>()
+	 *
+	 * Policy涨﷨JsonPolicy.hJson::parse<JsonStrictPolicy>(in, error)ϸRFC 8259ע
+	 * ָPolicyĽӿھʹJsonDefaultPolicy
+	 */
+	template <typename Policy>
+	static Json parse(std::string_view in, JsonError& error, JsonParseMode mode = STANDARD, int max_depth = Policy::max_depth);
+
+	template <typename Policy>
+	static Json parse(std::string_view in, std::string& err, JsonParseMode mode = STANDARD, int max_depth = Policy::max_depth);
 
-	static std::vector<Json> parse_multi(const std::string& in, std::string& err);
+	template <typename Policy>
+	static bool validate(std::string_view in, JsonError& error, int max_depth = Policy::max_depth);
+
+	template <typename Policy>
+	static bool validate(std::string_view in, std::string& err, int max_depth = Policy::max_depth);
+
+	template <typename Policy, typename Handler>
+	static bool parse_sax(std::string_view in, Handler& handler, JsonError& error, int max_depth = Policy::max_depth);
+
+	template <typename Policy, typename Handler>
+	static bool parse_sax(std::string_view in, Handler& handler, std::string& err, int max_depth = Policy::max_depth);
 
 	void dump(std::string& out) const;
 	std::string dump() const;
@@ -60,14 +232,106 @@ public:
 
 	bool bool_value() const;
 	int int_value() const;
+	// int64_value()uint64_value() ľȷֵضΪΧʱȡӽıֵ߽NaNΪ0
+	int64_t int64_value() const;
+	uint64_t uint64_value() const;
 	double number_value() const;
-	const std::string& string_value() const;
+	// string_value() ַĸַûпõstd::stringֻȡʱʹstring_view_value()Ҫ
+	std::string string_value() const;
+	std::string_view string_view_value() const;
 	const JsonArray& array_items() const;
 	const JsonObject& object_items() const;
 	const Json& operator[](size_t t) const;
-	const Json& operator[](const std::string& key) const;
+	// operator[] keyֱַstd::stringstd::string_viewʱṹstd::string
+	const Json& operator[](std::string_view key) const;
+	// ԤȼùϣֵJsonKeyңJsonObject.hʺڴĵзͬһ
+	const Json& operator[](const JsonKey& key) const;
+	// get() פļңJsonKeyTableINTERN_KEYSģʽĵеļȽʱֻȽָ
+	const Json& get(const ObjectKey& key) const;
 
 }; // Json
 
 
+}; // namespace json11
+
+#include "JsonObject.h"
+#include "JsonValue.h"
+#include "JsonParser.cpp"
+
+namespace json11 {
+
+template <typename T> requires (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+Json::Json(T value) noexcept : m_data{} {
+	if constexpr (std::is_unsigned_v<T>) {
+		if (static_cast<uint64_t>(value) > static_cast<uint64_t>(INT64_MAX)) {
+			m_data.scalar.storage = Storage::UINT;
+			m_data.scalar.value.uinteger = value;
+			return;
+		}
+	}
+	m_data.scalar.storage = Storage::INT;
+	m_data.scalar.value.integer = static_cast<int64_t>(value);
+}
+
+template <typename Handler>
+bool Json::parse_sax(std::string_view in, Handler& handler, JsonError& error, int max_depth) {
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	JsonParser parser(in, error, STANDARD, max_depth, nullptr, &*context);
+	return parser.parse_sax(handler);
+}
+
+template <typename Handler>
+bool Json::parse_sax(std::string_view in, Handler& handler, std::string& err, int max_depth) {
+	JsonError error;
+	const bool ok = parse_sax(in, handler, error, max_depth);
+	if (error) err += error.message();
+	return ok;
+}
+
+template <typename Policy>
+Json Json::parse(std::string_view in, JsonError& error, JsonParseMode mode, int max_depth) {
+	// parse()ͬIN_SITUģʽȽinƵһ鹲Ļ
+	const std::shared_ptr<const std::string> buffer = mode & IN_SITU ? std::make_shared<const std::string>(in) : nullptr;
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	BasicJsonParser<Policy> parser(buffer ? std::string_view(*buffer) : in, error, mode, max_depth, buffer, &*context);
+	return parser.parse();
+}
+
+template <typename Policy>
+Json Json::parse(std::string_view in, std::string& err, JsonParseMode mode, int max_depth) {
+	JsonError error;
+	Json result = parse<Policy>(in, error, mode, max_depth);
+	if (error) err += error.message();
+	return result;
+}
+
+template <typename Policy>
+bool Json::validate(std::string_view in, JsonError& error, int max_depth) {
+	BasicJsonParser<Policy> parser(in, error, STANDARD, max_depth);
+	return parser.validate();
+}
+
+template <typename Policy>
+bool Json::validate(std::string_view in, std::string& err, int max_depth) {
+	JsonError error;
+	const bool ok = validate<Policy>(in, error, max_depth);
+	if (!ok) err += error.message();
+	return ok;
+}
+
+template <typename Policy, typename Handler>
+bool Json::parse_sax(std::string_view in, Handler& handler, JsonError& error, int max_depth) {
+	const JsonParserContext::Lease context = JsonParserContext::local();
+	BasicJsonParser<Policy> parser(in, error, STANDARD, max_depth, nullptr, &*context);
+	return parser.parse_sax(handler);
+}
+
+template <typename Policy, typename Handler>
+bool Json::parse_sax(std::string_view in, Handler& handler, std::string& err, int max_depth) {
+	JsonError error;
+	const bool ok = parse_sax<Policy>(in, handler, error, max_depth);
+	if (error) err += error.message();
+	return ok;
+}
+
 }; // namespace json11
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace json11 {
+
+/* JsonArena
+ *
+ * Jsonĵʹõԣbumpڴ
+ * ڵһڴ˳з֣deallocate()κ飬ڴJsonArenaʱһͷ
+ * JsonArena̰߳ȫģֻJsonParserڼڴ棻ɺֻᱻJsonParserContextúã
+ */
+class JsonArena final {
+private:
+	// Block ΪһڴͷBlockԵʽʱͳһͷ
+	struct Block {
+		Block* next;
+	};
+
+	static constexpr size_t first_block_size = 4096;		// һڴĴССĵֻҪһ
+	static constexpr size_t max_block_size = 1 << 20;		// ÿڴĴСmax_block_size
+
+	Block* head;			// һڴ
+	char* cur;				// ǰһηʼλ
+	char* end;				// ǰĩβ
+	size_t next_size;		// һڴĴС
+
+	/* grow()
+	 *
+	 * ǰʣռ䲻ʱһbytesֽڣalign룩ڴ
+	 */
+	void grow(size_t bytes, size_t align) {
+		size_t size = next_size;
+		while (size < bytes + align + sizeof(Block)) size *= 2;
+		if (next_size < max_block_size) next_size *= 2;
+
+		Block* block = static_cast<Block*>(std::malloc(size));
+		if (!block) throw std::bad_alloc();
+		block->next = head;
+		head = block;
+		cur = reinterpret_cast<char*>(block + 1);
+		end = reinterpret_cast<char*>(block) + size;
+	}
+
+public:
+	JsonArena() : head(nullptr), cur(nullptr), end(nullptr), next_size(first_block_size) {}
+	JsonArena(const JsonArena&) = delete;
+	JsonArena& operator= (const JsonArena&) = delete;
+	~JsonArena() {
+		while (head) {
+			Block* next = head->next;
+			std::free(head);
+			head = next;
+		}
+	}
+
+	/* reset()
+	 *
+	 * ͷųһ飨Ҳһ飩ڴ棬һĿͷ·
+	 * ֻûκνڵʹarenaʱãJsonParserContextڶĵ֮临ͬһarena
+	 */
+	void reset() {
+		if (!head) return;
+		Block* next = head->next;
+		while (next) {
+			Block* after = next->next;
+			std::free(next);
+			next = after;
+		}
+		head->next = nullptr;
+		cur = reinterpret_cast<char*>(head + 1);
+	}
+
+	/* allocate()
+	 *
+	 * ӵǰзֳbytesֽڣalign룩ڴ
+	 */
+	void* allocate(size_t bytes, size_t align) {
+		size_t pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+		if (!cur || static_cast<size_t>(end - cur) < bytes + pad) {
+			grow(bytes, align);
+			pad = (align - reinterpret_cast<size_t>(cur) % align) % align;
+		}
+		char* result = cur + pad;
+		cur = result + bytes;
+		return result;
+	}
+};
+
+/* ArenaAllocator<T>
+ *
+ * ObjectKey::allocate()ʹõķJsonArenaзĳ
+ * ÿһArenaAllocatorһshared_ptr<JsonArena>ַ顢ڵҲԳһݣJson::make()
+ * ֻҪĵлнڵJsonArenaͲᱻͷţһڵʱڴһԹ黹
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+	using value_type = T;
+
+	std::shared_ptr<JsonArena> arena;
+
+	explicit ArenaAllocator(std::shared_ptr<JsonArena> arena_v) noexcept : arena(std::move(arena_v)) {}
+	template <typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T*, size_t) noexcept {}
+
+	template <typename U>
+	bool operator== (const ArenaAllocator<U>& rhs) const noexcept { return arena == rhs.arena; }
+	template <typename U>
+	bool operator!= (const ArenaAllocator<U>& rhs) const noexcept { return arena != rhs.arena; }
+};
+
+};
@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+namespace json11 {
+
+// ʾпܷĴ
+enum JsonErrorCode {
+	ERR_NONE = 0,				// ûз
+	ERR_UNEXPECTED_END,			// һֵ֮ǰѾ
+	ERR_UNEXPECTED_CHAR,		// ˴Ӧַ
+	ERR_TRAILING_CONTENT,		// һֵ֮
+	ERR_DEPTH_EXCEEDED,			// Ƕײγmax_depth
+	ERR_INVALID_LITERAL,		// truefalsenullƴд
+	ERR_NUMBER_LEADING_ZERO,	// 0
+	ERR_NUMBER_MISSING_DIGIT,	// źû
+	ERR_NUMBER_FRACTION,		// Сû
+	ERR_NUMBER_EXPONENT,		// ָû
+	ERR_STRING_UNTERMINATED,	// ַûн
+	ERR_STRING_CONTROL_CHAR,	// ַгַֿ
+	ERR_STRING_INVALID_ESCAPE,	// תַ
+	ERR_STRING_UNICODE_ESCAPE,	// \u4ʮ
+	ERR_STRING_INVALID_UTF8,	// ַгַǷUTF-8
+	ERR_ARRAY_MISSING_COMMA,	// Ԫ֮ȱ','
+	ERR_OBJECT_MISSING_KEY,		// ȱټ
+	ERR_OBJECT_MISSING_COLON,	// ֮ȱ':'
+	ERR_OBJECT_MISSING_COMMA,	// ֵ֮ȱ','
+	ERR_OBJECT_DUPLICATE_KEY,	// гظļDUPLICATE_REJECT
+	ERR_COMMENT_INCOMPLETE,		// ֻһ'/'
+	ERR_COMMENT_INVALID,		// '/'֮Ȳ'/'Ҳ'*'
+	ERR_COMMENT_UNTERMINATED,	// עûн
+	ERR_HANDLER_ABORTED,		// SAX handlerfalse
+	ERR_LAZY_UNSUPPORTED,		// JsonLazy޷루עͻ򳬹4GB
+	ERR_NULL_INPUT,				// Ϊָ
+	ERR_FILE						// ޷򿪡ȡӳļ
+};
+
+/* JsonError
+ *
+ * ṹĽ󣺴Լλãֽƫƣ1ʼккţкŰֽڼ㣩
+ * ֻ¼⼸ڴ棻Ϣֻڵmessage()ʱ
+ */
+struct JsonError {
+	JsonErrorCode code = ERR_NONE;
+	size_t offset = 0;
+	size_t line = 0;
+	size_t column = 0;
+
+	explicit operator bool() const { return code != ERR_NONE; }
+
+	/* set()
+	 *
+	 * ¼룬inputoffsetкк
+	 */
+	void set(JsonErrorCode code_v, std::string_view input, size_t offset_v) {
+		code = code_v;
+		offset = std::min(offset_v, input.size());
+		const std::string_view prefix = input.substr(0, offset);
+		line = 1 + static_cast<size_t>(std::count(prefix.begin(), prefix.end(), '\n'));
+		const size_t line_start = prefix.rfind('\n');
+		column = offset - (line_start == std::string_view::npos ? 0 : line_start + 1) + 1;
+	}
+
+	static const char* description(JsonErrorCode code) {
+		switch (code) {
+		case ERR_NONE:					return "ûд";
+		case ERR_UNEXPECTED_END:		return "stringĩβjson";
+		case ERR_UNEXPECTED_CHAR:		return "δ֪";
+		case ERR_TRAILING_CONTENT:		return "unexpected trailing";
+		case ERR_DEPTH_EXCEEDED:		return "ι";
+		case ERR_INVALID_LITERAL:		return "truefalsenullƴд";
+		case ERR_NUMBER_LEADING_ZERO:	return "0ֲֹ淶";
+		case ERR_NUMBER_MISSING_DIGIT:	return "Ҫһλ";
+		case ERR_NUMBER_FRACTION:		return "С";
+		case ERR_NUMBER_EXPONENT:		return "ָźҪһ";
+		case ERR_STRING_UNTERMINATED:	return "ַ";
+		case ERR_STRING_CONTROL_CHAR:	return "ַгַ";
+		case ERR_STRING_INVALID_ESCAPE:	return "ִתַ";
+		case ERR_STRING_UNICODE_ESCAPE:	return R"(\uַ)";
+		case ERR_STRING_INVALID_UTF8:	return "ַгַǷUTF-8";
+		case ERR_ARRAY_MISSING_COMMA:	return "ȱ','";
+		case ERR_OBJECT_MISSING_KEY:	return "ȱ '\"'";
+		case ERR_OBJECT_MISSING_COLON:	return "ȱ ':'";
+		case ERR_OBJECT_MISSING_COMMA:	return "ȱ ','";
+		case ERR_OBJECT_DUPLICATE_KEY:	return "дظļ";
+		case ERR_COMMENT_INCOMPLETE:	return "ֻһ/޷жǷΪע";
+		case ERR_COMMENT_INVALID:		return "עʹڴ";
+		case ERR_COMMENT_UNTERMINATED:	return "עʹڴ";
+		case ERR_HANDLER_ABORTED:		return "handlerֹ˽";
+		case ERR_LAZY_UNSUPPORTED:		return "JsonLazy֧עԼ4GB";
+		case ERR_NULL_INPUT:			return "null input";
+		case ERR_FILE:					return "޷򿪡ȡӳļ";
+		}
+		return "δ֪";
+	}
+
+	/* message()
+	 *
+	 * ɴϢ֣ʽ֮ǰдerrһ
+	 */
+	std::string message() const {
+		if (code == ERR_NONE) return std::string();
+		return std::string("Ϣ") + description(code) + ", λ: " + std::to_string(line) + "е"
+			+ std::to_string(column) + "Уֽƫ" + std::to_string(offset) + "";
+	}
+};
+
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include "json11_namespace.h"
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace json11 {
+
+/* JsonKeyTable
+ *
+ * פinternͬݵĳֻһݣObjectKeyͬ
+ * ߳̿ͬʱʹͬһֻӹֻеһĳʱżӶռ
+ * JsonParserڽڼ仹ڱػѾפļظļÿζ
+ *
+ * ΪֹidΪеļﵽcapacity֮ٲ룬֮¼פ
+ * clear()ֻձѾĵȻиԵļ
+ */
+class JsonKeyTable final {
+private:
+	mutable std::shared_mutex mutex;
+	std::unordered_map<std::string_view, ObjectKey> keys; // string_viewָӦObjectKey
+	const size_t capacity;
+
+public:
+	static constexpr size_t default_capacity = 1 << 16;
+
+	explicit JsonKeyTable(size_t capacity_v = default_capacity) : capacity(capacity_v) {}
+	JsonKeyTable(const JsonKeyTable&) = delete;
+	JsonKeyTable& operator= (const JsonKeyTable&) = delete;
+
+	/* intern()
+	 *
+	 * ΪkeyObjectKeyͬļʱ֮ͬһڴ
+	 * ֱ̼ӱObjectKeyڲȲ죬˲
+	 */
+	ObjectKey intern(std::string_view key) {
+		if (key.size() <= ObjectKey::inline_capacity) return ObjectKey(key);
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			const auto it = keys.find(key);
+			if (it != keys.end()) return it->second;
+			if (keys.size() >= capacity) return ObjectKey(key);
+		}
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		const auto it = keys.find(key);
+		if (it != keys.end()) return it->second;
+		if (keys.size() >= capacity) return ObjectKey(key);
+		ObjectKey interned(key);
+		keys.emplace(interned.view(), interned);
+		return interned;
+	}
+
+	size_t size() const {
+		std::shared_lock<std::shared_mutex> lock(mutex);
+		return keys.size();
+	}
+
+	void clear() {
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		keys.clear();
+	}
+
+	// global() ڷINTERN_KEYSģʽJsonParserõı
+	static JsonKeyTable& global() {
+		static JsonKeyTable table;
+		return table;
+	}
+};
+
+};
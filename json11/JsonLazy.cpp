@@ -0,0 +1,283 @@
+#include "JsonLazy.h"
+
+namespace json11 {
+
+namespace {
+/* ScalarHandler
+ *
+ * ȡֵʱJsonParser::parse_value()handlerʱֹ
+ */
+struct ScalarHandler {
+	bool boolean = false;
+	Json number; // Jsonһȷ棬Jsonķʽӿת
+	std::string string;
+
+	bool on_null() { return true; }
+	bool on_bool(bool value) { boolean = value; return true; }
+	bool on_number(double value) { number = Json(value); return true; }
+	bool on_int64(int64_t value) { number = Json(value); return true; }
+	bool on_uint64(uint64_t value) { number = Json(value); return true; }
+	bool on_string(std::string_view value) { string.assign(value.data(), value.size()); return true; }
+	bool on_key(std::string_view) { return false; }
+	bool on_start_array() { return false; }
+	bool on_end_array(size_t) { return false; }
+	bool on_start_object() { return false; }
+	bool on_end_object(size_t) { return false; }
+};
+
+/* decode()
+ *
+ * JsonParserstr[begin, end)һֻֿհףto_json()ͬJsonParser::parse_value()飩
+ */
+bool decode(const std::string& str, size_t begin, size_t end, ScalarHandler& handler) {
+	JsonError error;
+	JsonParser parser(str, begin, error);
+	return parser.parse_value(handler, end);
+}
+
+/* valid_literal()
+ *
+ * strpostruefalsenullƴдҵһtokenʼλnext֮ǰֻпհףų nullztruex
+ */
+bool valid_literal(const std::string& str, size_t pos, size_t next) {
+	const std::string_view literal = str[pos] == 'n' ? "null" : str[pos] == 't' ? "true" : "false";
+	if (str.compare(pos, literal.size(), literal) != 0) return false;
+	for (size_t p = pos + literal.size(); p < next; ++p) {
+		if (str[p] != ' ' && str[p] != '\r' && str[p] != '\n' && str[p] != '\t') return false;
+	}
+	return true;
+}
+}
+
+/* parse()
+ *
+ * ṹɨ裺ڽṹϰ ֵ -> ',' /  ˳﷨һʽջΪÿ¼ƥĽ
+ * һֻеtokenӴֵַݣֻtruefalsenullƴдʹtype()Ľɿ
+ */
+JsonLazy JsonLazy::parse(std::string&& in, JsonError& error) {
+	enum Expect { VALUE, VALUE_OR_END, KEY, KEY_OR_END, COLON, COMMA_OR_END, DONE };
+
+	std::shared_ptr<Document> document = std::make_shared<Document>();
+	document->str = std::move(in);
+	const std::string& str = document->str;
+	std::vector<uint32_t>& indexes = document->indexes;
+	std::vector<uint32_t>& match = document->match;
+
+	auto fail = [&](JsonErrorCode code, size_t pos) {
+		error.set(code, str, pos);
+		return JsonLazy();
+	};
+
+	if (!JsonScanner::scan(str, 0, str.size(), indexes)) {
+		return fail(ERR_LAZY_UNSUPPORTED, 0);
+	}
+	match.assign(indexes.size(), 0);
+
+	std::vector<uint32_t> open; // δindexesе±
+	Expect expect = VALUE;
+	for (uint32_t n = 0; n < indexes.size(); ++n) {
+		const size_t pos = indexes[n];
+		const char ch = str[pos];
+		bool value_done = false;
+		switch (expect) {
+		case VALUE:
+		case VALUE_OR_END:
+			if (ch == '[' || ch == '{') {
+				open.push_back(n);
+				expect = ch == '[' ? VALUE_OR_END : KEY_OR_END;
+			} else if (ch == ']' && expect == VALUE_OR_END) {
+				match[open.back()] = n;
+				open.pop_back();
+				value_done = true;
+			} else if (ch == '"' || ch == '-' || (ch >= '0' && ch <= '9')) {
+				value_done = true;
+			} else if (ch == 't' || ch == 'f' || ch == 'n') {
+				if (!valid_literal(str, pos, n + 1 < indexes.size() ? indexes[n + 1] : str.size())) return fail(ERR_INVALID_LITERAL, pos);
+				value_done = true;
+			} else {
+				return fail(ERR_UNEXPECTED_CHAR, pos);
+			}
+			break;
+		case KEY:
+		case KEY_OR_END:
+			if (ch == '"') {
+				expect = COLON;
+			} else if (ch == '}' && expect == KEY_OR_END) {
+				match[open.back()] = n;
+				open.pop_back();
+				value_done = true;
+			} else {
+				return fail(ERR_OBJECT_MISSING_KEY, pos);
+			}
+			break;
+		case COLON:
+			if (ch != ':') return fail(ERR_OBJECT_MISSING_COLON, pos);
+			expect = VALUE;
+			break;
+		case COMMA_OR_END: {
+			const bool in_object = str[indexes[open.back()]] == '{';
+			if (ch == ',') {
+				expect = in_object ? KEY : VALUE;
+			} else if (ch == (in_object ? '}' : ']')) {
+				match[open.back()] = n;
+				open.pop_back();
+				value_done = true;
+			} else {
+				return fail(in_object ? ERR_OBJECT_MISSING_COMMA : ERR_ARRAY_MISSING_COMMA, pos);
+			}
+			break;
+		}
+		case DONE:
+			return fail(ERR_TRAILING_CONTENT, pos);
+		}
+		if (value_done) expect = open.empty() ? DONE : COMMA_OR_END;
+	}
+	if (expect != DONE) {
+		return fail(ERR_UNEXPECTED_END, str.size());
+	}
+	return JsonLazy(std::move(document), 0);
+}
+
+JsonLazy JsonLazy::parse(std::string_view in, JsonError& error) {
+	return parse(std::string(in), error);
+}
+
+JsonLazy JsonLazy::parse(std::string&& in, std::string& err) {
+	JsonError error;
+	JsonLazy result = parse(std::move(in), error);
+	if (error) err += error.message();
+	return result;
+}
+
+JsonLazy JsonLazy::parse(std::string_view in, std::string& err) {
+	return parse(std::string(in), err);
+}
+
+/* end()
+ *
+ * ǰֵstrеĽλãΪƥĽ֮󣬱Ϊһtokenʼλ
+ */
+size_t JsonLazy::end() const {
+	const char ch = first_char();
+	if (ch == '[' || ch == '{') return doc->indexes[doc->match[k]] + 1;
+	return k + 1 < doc->indexes.size() ? doc->indexes[k + 1] : doc->str.size();
+}
+
+/* next()
+ *
+ * indexes[k_v]ֵһtoken±ꣻֱƥĽ֮
+ */
+uint32_t JsonLazy::next(uint32_t k_v) const {
+	const char ch = doc->str[doc->indexes[k_v]];
+	return (ch == '[' || ch == '{') ? doc->match[k_v] + 1 : k_v + 1;
+}
+
+/* type()
+ *
+ * ֻݵһַжͣtruefalsenullƴдѾparse()м
+ * ֱֵַȡʱż飬ʽʱto_json()ʽӿڷĬֵ
+ */
+json11::JsonType JsonLazy::type() const {
+	if (!doc) return NUL;
+	switch (first_char()) {
+	case 'n': return NUL;
+	case 't':
+	case 'f': return BOOL;
+	case '"': return STRING;
+	case '[': return ARRAY;
+	case '{': return OBJECT;
+	default: return NUMBER;
+	}
+}
+
+bool JsonLazy::bool_value() const {
+	ScalarHandler handler;
+	return is_bool() && decode(doc->str, begin(), end(), handler) && handler.boolean;
+}
+
+Json JsonLazy::number() const {
+	ScalarHandler handler;
+	return is_number() && decode(doc->str, begin(), end(), handler) ? std::move(handler.number) : Json();
+}
+
+int JsonLazy::int_value() const {
+	return number().int_value();
+}
+
+int64_t JsonLazy::int64_value() const {
+	return number().int64_value();
+}
+
+uint64_t JsonLazy::uint64_value() const {
+	return number().uint64_value();
+}
+
+double JsonLazy::number_value() const {
+	return number().number_value();
+}
+
+std::string JsonLazy::string_value() const {
+	ScalarHandler handler;
+	return is_string() && decode(doc->str, begin(), end(), handler) ? std::move(handler.string) : std::string();
+}
+
+size_t JsonLazy::size() const {
+	if (!is_array() && !is_object()) return 0;
+	const bool object = is_object();
+	size_t count = 0;
+	// ÿԪΪ  ':' ֵ ','Ϊ ֵ ','
+	for (uint32_t n = k + 1; n != doc->match[k]; ++count) {
+		if (object) n += 2;
+		n = next(n);
+		if (n != doc->match[k]) ++n;
+	}
+	return count;
+}
+
+JsonLazy JsonLazy::operator[](size_t i) const {
+	if (!is_array()) return JsonLazy();
+	for (uint32_t n = k + 1; n != doc->match[k]; --i) {
+		if (i == 0) return JsonLazy(doc, n);
+		n = next(n);
+		if (n != doc->match[k]) ++n;
+	}
+	return JsonLazy();
+}
+
+JsonLazy JsonLazy::operator[](std::string_view key) const {
+	if (!is_object()) return JsonLazy();
+	const std::string& str = doc->str;
+	JsonLazy result;
+	for (uint32_t n = k + 1; n != doc->match[k];) {
+		// ûתַʱֱӱȽԭʼֽڣȽ
+		const char* key_begin = str.data() + doc->indexes[n] + 1;
+		const char* key_end = JsonScanner::find_string_special(key_begin, str.data() + str.size());
+		bool equal;
+		if (key_end != str.data() + str.size() && *key_end == '"') {
+			equal = std::string_view(key_begin, key_end - key_begin) == key;
+		} else {
+			ScalarHandler handler;
+			equal = decode(str, doc->indexes[n], doc->indexes[n + 1], handler) && handler.string == key;
+		}
+		// Json::parse()ͬظļһγֵֵΪ׼
+		if (equal) result = JsonLazy(doc, n + 2);
+		n = next(n + 2);
+		if (n != doc->match[k]) ++n;
+	}
+	return result;
+}
+
+Json JsonLazy::to_json(JsonError& error) const {
+	if (!doc) return Json();
+	JsonParser parser(doc->str, begin(), error);
+	return parser.parse_value(end());
+}
+
+Json JsonLazy::to_json(std::string& err) const {
+	JsonError error;
+	Json result = to_json(error);
+	if (error) err += error.message();
+	return result;
+}
+
+};
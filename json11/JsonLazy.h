@@ -0,0 +1,85 @@
+#pragma once
+#include "Json11.h"
+#include <string_view>
+
+namespace json11 {
+/* JsonLazy
+ *
+ * Jsonĵ
+ * JsonLazy::parse()ֻһṹɨ裺JsonScannerɽṹϼ﷨Ϊÿ'[''{'¼֮ƥĽ
+ * ֮doc["a"]["b"]ʱֻ;ȽϼƥĽֱҪ
+ * ֵַֻ֡ڱȡʱŻ룬δʵֵκJson
+ *
+ * JsonLazyָֻĵĳֵľ⸴ƣоͬͬһṹ
+ * ṹɨֻššðŵȵ˳ֵĺϷڶȡʱż飬ȡʧʱJsonͬĬֵ
+ * дעʱ޷ɽṹʱparse()ҪJson::parse()
+ */
+class JsonLazy final {
+private:
+	// Document Ϊһĵ
+	struct Document {
+		std::string str; // 
+		std::vector<uint32_t> indexes; // ṹ
+		std::vector<uint32_t> match; // match[k]Ϊindexes[k]'[''{'ӦĽindexesе±
+	};
+
+	std::shared_ptr<const Document> doc; // Ϊʱʾһڵֵnullͬ
+	uint32_t k; // ǰֵĵһtokendoc->indexesе±
+
+	JsonLazy(std::shared_ptr<const Document> doc_v, uint32_t k_v) : doc(std::move(doc_v)), k(k_v) {}
+
+	char first_char() const { return doc->str[doc->indexes[k]]; }
+	size_t begin() const { return doc->indexes[k]; }
+	size_t end() const;
+	uint32_t next(uint32_t k_v) const;
+	// number() ڽ뵱ǰ֣ʱnull
+	Json number() const;
+
+public:
+	JsonLazy() noexcept : k(0) {}
+
+	/* parse()
+	 *
+	 * inһṹɨ裬ָ򶥲ֵJsonLazy
+	 * ֮ʸֵʱҪȡ룬ĵУstd::string&&汾ֱӽӹin
+	 * std::string_view汾ȽinһݣѾӵstd::stringʱӦmoveԱθ
+	 * ʱزڵֵerrorм¼λã򽫴Ϣ׷ӵerr
+	 */
+	static JsonLazy parse(std::string_view in, JsonError& error);
+	static JsonLazy parse(std::string&& in, JsonError& error);
+	static JsonLazy parse(std::string_view in, std::string& err);
+	static JsonLazy parse(std::string&& in, std::string& err);
+
+	json11::JsonType type() const;
+	bool is_null()   const { return type() == NUL; }
+	bool is_bool()   const { return type() == BOOL; }
+	bool is_number() const { return type() == NUMBER; }
+	bool is_string() const { return type() == STRING; }
+	bool is_array()  const { return type() == ARRAY; }
+	bool is_object() const { return type() == OBJECT; }
+	// exists() жϵǰֵǷڣoperator[]ҲӦԪʱزڵֵ
+	bool exists() const { return doc != nullptr; }
+
+	bool bool_value() const;
+	int int_value() const;
+	int64_t int64_value() const;
+	uint64_t uint64_value() const;
+	double number_value() const;
+	std::string string_value() const;
+
+	// size() ڷԪظļֵԸҪһԪأᱻֱ
+	size_t size() const;
+	// operator[] ֻ/һвңԪزᱻ
+	JsonLazy operator[](size_t i) const;
+	JsonLazy operator[](std::string_view key) const;
+
+	/* to_json()
+	 *
+	 * ǰֵΪJson
+	 * Ĵλü¼errorУ򽫴Ϣ׷ӵerrλΪеƫк
+	 */
+	Json to_json(JsonError& error) const;
+	Json to_json(std::string& err) const;
+};
+
+};
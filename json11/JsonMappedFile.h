@@ -0,0 +1,103 @@
+#pragma once
+#include "JsonError.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JSON11_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace json11 {
+
+/* JsonMappedFile
+ *
+ * Json::parse_file()ʹõֻļӳ䣬JsonParserֱӳϽ
+ * ֧mmapƽ̨˻Ϊļstd::string
+ *
+ * IN_SITUģʽJsonMappedFileΪStringRefValueownerӳһֱһĽڵ
+ */
+class JsonMappedFile final {
+private:
+	const char* m_data;
+	size_t m_size;
+#ifdef JSON11_MMAP
+	void* m_base;		// ӳʼַΪʱʾļ
+#else
+	std::string m_buffer;
+#endif
+
+	JsonMappedFile() : m_data(""), m_size(0)
+#ifdef JSON11_MMAP
+		, m_base(nullptr)
+#endif
+	{}
+
+public:
+	JsonMappedFile(const JsonMappedFile&) = delete;
+	JsonMappedFile& operator= (const JsonMappedFile&) = delete;
+	~JsonMappedFile() {
+#ifdef JSON11_MMAP
+		if (m_base) munmap(m_base, m_size);
+#endif
+	}
+
+	std::string_view view() const { return std::string_view(m_data, m_size); }
+
+	/* open()
+	 *
+	 * ӳpathӦļʧʱؿָ벢errorм¼ERR_FILE
+	 */
+	static std::shared_ptr<const JsonMappedFile> open(const std::string& path, JsonError& error) {
+		std::shared_ptr<JsonMappedFile> file(new JsonMappedFile());
+#ifdef JSON11_MMAP
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			error.set(ERR_FILE, std::string_view(), 0);
+			return nullptr;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0) {
+			::close(fd);
+			error.set(ERR_FILE, std::string_view(), 0);
+			return nullptr;
+		}
+		const size_t size = static_cast<size_t>(st.st_size);
+		if (size > 0) {
+			void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (base == MAP_FAILED) {
+				::close(fd);
+				error.set(ERR_FILE, std::string_view(), 0);
+				return nullptr;
+			}
+			// JsonParserͷβ˳ȡһ飬ʾںǰԤնҳ
+			madvise(base, size, MADV_SEQUENTIAL);
+			file->m_base = base;
+			file->m_data = static_cast<const char*>(base);
+			file->m_size = size;
+		}
+		::close(fd);
+#else
+		std::ifstream in(path, std::ios::binary);
+		if (!in) {
+			error.set(ERR_FILE, std::string_view(), 0);
+			return nullptr;
+		}
+		std::ostringstream buffer;
+		buffer << in.rdbuf();
+		file->m_buffer = std::move(buffer).str();
+		file->m_data = file->m_buffer.c_str();
+		file->m_size = file->m_buffer.size();
+#endif
+		return file;
+	}
+};
+
+};
@@ -0,0 +1,262 @@
+#pragma once
+#include "json11_namespace.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+// ļJson11.hJsonĶ֮룬ԱеJsonҪΪ
+namespace json11 {
+
+/* JsonKey
+ *
+ * ԤȼùϣֵļʺʱһΣ֮ڴĵзͬһңjs[key]JsonObject::find(key)
+ * ڴйϣĶ󣨳ԱJsonObject::hash_thresholdвʱֱʹñĹϣֵٶԼϣ
+ * ͬʱ˳ԱĹϣֵֻйϣֵͬĳԱҪȽַ
+ * JsonKeyTable::intern()õĳʱINTERN_KEYSģʽĵеļȽֻȽָ
+ * JsonKey󲻿޸ģԱ߳ͬʱʹ
+ */
+class JsonKey final {
+private:
+	ObjectKey m_key;
+	size_t m_hash;
+public:
+	explicit JsonKey(std::string_view key) : m_key(key), m_hash(hash(key)) {}
+	explicit JsonKey(const std::string& key) : JsonKey(std::string_view(key)) {}
+	explicit JsonKey(const char* key) : JsonKey(std::string_view(key)) {}
+	explicit JsonKey(ObjectKey key) : m_key(std::move(key)), m_hash(hash(m_key.view())) {}
+
+	const ObjectKey& key() const { return m_key; }
+	std::string_view view() const { return m_key.view(); }
+	size_t size() const { return m_key.view().size(); }
+	size_t hash() const { return m_hash; }
+
+	// hash() ڼĹϣֵJsonObjectĹϣʹͬһ
+	static size_t hash(std::string_view key) { return std::hash<std::string_view>()(key); }
+};
+
+/* JsonObject
+ *
+ * JsonеĶ󣺼ֵ԰˳ͬһvectorУԼdump()˳ԭstd::mapͬ
+ * Աhash_thresholdʱֲңʱ⽨һѰַĹϣԱ±ԼĹϣֵ
+ * ֻһιϣJsonKeyʱһҲҪ
+ * õĽӿstd::map<std::string, Json>ͬfind()count()emplace()insert_or_assign()erase()operator[]Լ
+ *
+ * std::mapͬǣ롢ɾҪƶĳԱ֮ʧЧ
+ * 롢ɾᶪϣ˺Ĳ˻Ϊֲңbuild_index()½Json(JsonObject)ʱԶã
+ * ԱĴֻƶԱÿζ¼мĹϣ
+ * ҪһμܶԱʱӦȷvectorfrom_unsorted()һԹJsonParserˣ
+ * ֻͨ޸ֵ޸ļԱ˳ʧЧ
+ */
+class JsonObject final {
+public:
+	using key_type = ObjectKey;
+	using mapped_type = Json;
+	using value_type = std::pair<ObjectKey, Json>;
+	using size_type = size_t;
+	using iterator = std::vector<value_type>::iterator;
+	using const_iterator = std::vector<value_type>::const_iterator;
+
+	static constexpr size_t hash_threshold = 16;
+
+private:
+	std::vector<value_type> m_members; // ûظļ
+	std::vector<uint64_t> m_index; // ϣλе32λΪԱ±10Ϊղλ32λΪĹϣǣԱhash_threshold롢ɾԱ֮Ϊգbuild_index()
+
+	static bool key_less(const value_type& lhs, const value_type& rhs) { return lhs.first.view() < rhs.first.view(); }
+	// tag() ɼĹϣֵõе32λǣǲͬļһ
+	static uint32_t tag(size_t hash) { return static_cast<uint32_t>(static_cast<uint64_t>(hash) >> 32 ^ hash); }
+
+	// lower_bound() ڶֲҵһСkeyĳԱ±
+	size_t lower_bound(std::string_view key) const {
+		size_t first = 0, count = m_members.size();
+		while (count > 0) {
+			const size_t half = count / 2;
+			if (m_members[first + half].first.view() < key) {
+				first += half + 1;
+				count -= half + 1;
+			} else {
+				count = half;
+			}
+		}
+		return first;
+	}
+
+	/* find_index()
+	 *
+	 * ؼΪkeyĳԱ±꣬ʱsize()
+	 * keyΪObjectKeyJsonKeyʱԱļȱȽָ루ObjectKey::operator==
+	 */
+	template <typename K>
+	size_t find_index(const K& key) const {
+		const std::string_view view(key);
+		return m_index.empty() ? find_sorted(key, view) : find_hashed(key, JsonKey::hash(view));
+	}
+	size_t find_index(const JsonKey& key) const {
+		return m_index.empty() ? find_sorted(key.key(), key.view()) : find_hashed(key.key(), key.hash());
+	}
+	template <typename K>
+	size_t find_sorted(const K& key, std::string_view view) const {
+		const size_t k = lower_bound(view);
+		return k < m_members.size() && m_members[k].first == key ? k : m_members.size();
+	}
+	template <typename K>
+	size_t find_hashed(const K& key, size_t hash) const {
+		const size_t mask = m_index.size() - 1;
+		const uint32_t key_tag = tag(hash);
+		for (size_t slot = hash & mask; m_index[slot]; slot = (slot + 1) & mask) {
+			if (static_cast<uint32_t>(m_index[slot] >> 32) != key_tag) continue;
+			const size_t k = static_cast<uint32_t>(m_index[slot]) - 1;
+			if (m_members[k].first == key) return k;
+		}
+		return m_members.size();
+	}
+
+	// invalidate_index() ڲ롢ɾԱϣֱһbuild_index()
+	void invalidate_index() noexcept {
+		if (!m_index.empty()) std::vector<uint64_t>().swap(m_index);
+	}
+
+	// rebuild_index() ½ϣλΪСڳԱ2
+	void rebuild_index() {
+		if (m_members.size() <= hash_threshold) {
+			std::vector<uint64_t>().swap(m_index);
+			return;
+		}
+		size_t capacity = hash_threshold * 4;
+		while (capacity < m_members.size() * 2) capacity *= 2;
+		m_index.assign(capacity, 0);
+		const size_t mask = capacity - 1;
+		for (size_t k = 0; k < m_members.size(); ++k) {
+			const size_t hash = JsonKey::hash(m_members[k].first.view());
+			size_t slot = hash & mask;
+			while (m_index[slot]) slot = (slot + 1) & mask;
+			m_index[slot] = static_cast<uint64_t>(tag(hash)) << 32 | static_cast<uint32_t>(k + 1);
+		}
+	}
+
+	/* insert()
+	 *
+	 * ΪkeyĳԱѾʱassignΪtrue򸲸ԭֵ򱣳ֲ
+	 */
+	template <typename K, typename V>
+	std::pair<iterator, bool> insert(K&& key, V&& value, bool assign) {
+		const size_t k = lower_bound(std::string_view(key));
+		if (k < m_members.size() && m_members[k].first == key) {
+			if (assign) m_members[k].second = Json(std::forward<V>(value));
+			return { m_members.begin() + k, false };
+		}
+		m_members.emplace(m_members.begin() + k, ObjectKey(std::forward<K>(key)), Json(std::forward<V>(value)));
+		invalidate_index();
+		return { m_members.begin() + k, true };
+	}
+
+public:
+	JsonObject() noexcept {}
+	// std::mapͬinitializer_listظļԵһγֵΪ׼
+	JsonObject(std::initializer_list<value_type> members) : JsonObject(from_unsorted(std::vector<value_type>(members), false)) {}
+
+	/* from_unsorted()
+	 *
+	 * ˳membersһԹֻһΡһmembersڴֱӳΪĴ洢
+	 * ظļһΣkeep_lastΪtrueһγֵֵduplicateΪʱ¼Ƿظļ
+	 * ԱʱʹòڴĲѾmembersᱻƶ
+	 */
+	static JsonObject from_unsorted(std::vector<value_type>&& members, bool keep_last = true, bool* duplicate = nullptr) {
+		JsonObject result;
+		std::vector<value_type>& m = result.m_members;
+		m = std::move(members);
+		bool has_duplicate = false;
+		if (std::adjacent_find(m.begin(), m.end(), [](const value_type& lhs, const value_type& rhs) { return !key_less(lhs, rhs); }) != m.end()) {
+			if (m.size() <= 32) {
+				for (size_t k = 1; k < m.size(); ++k) {
+					if (!key_less(m[k], m[k - 1])) continue;
+					value_type member = std::move(m[k]);
+					size_t j = k;
+					do {
+						m[j] = std::move(m[j - 1]);
+						--j;
+					} while (j > 0 && key_less(member, m[j - 1]));
+					m[j] = std::move(member);
+				}
+			} else {
+				std::stable_sort(m.begin(), m.end(), key_less);
+			}
+			// ͬļڣұԭȺ˳
+			size_t out = 0;
+			for (size_t k = 0; k < m.size();) {
+				size_t end = k + 1;
+				while (end < m.size() && m[end].first == m[k].first) ++end;
+				if (end - k > 1) has_duplicate = true;
+				const size_t keep = keep_last ? end - 1 : k;
+				if (out != keep) m[out] = std::move(m[keep]);
+				++out;
+				k = end;
+			}
+			m.erase(m.begin() + out, m.end());
+		}
+		if (duplicate) *duplicate = has_duplicate;
+		result.rebuild_index();
+		return result;
+	}
+
+	iterator begin() noexcept { return m_members.begin(); }
+	iterator end() noexcept { return m_members.end(); }
+	const_iterator begin() const noexcept { return m_members.begin(); }
+	const_iterator end() const noexcept { return m_members.end(); }
+	const_iterator cbegin() const noexcept { return m_members.cbegin(); }
+	const_iterator cend() const noexcept { return m_members.cend(); }
+
+	/* build_index()
+	 *
+	 * Աhash_thresholdһûйϣղ롢ɾԱʱ
+	 * ᱻãJson(JsonObject)ڶΪġ޸ĵĽڵ֮ǰһΣҪڶJsonObjectϷʱҲֶ
+	 */
+	void build_index() {
+		if (m_index.empty() && m_members.size() > hash_threshold) rebuild_index();
+	}
+
+	size_t size() const noexcept { return m_members.size(); }
+	bool empty() const noexcept { return m_members.empty(); }
+	void clear() noexcept {
+		m_members.clear();
+		invalidate_index();
+	}
+
+	// find()count() keyJsonKeyObjectKeystd::stringstd::string_viewconst char*
+	template <typename K>
+	iterator find(const K& key) { return m_members.begin() + find_index(key); }
+	template <typename K>
+	const_iterator find(const K& key) const { return m_members.begin() + find_index(key); }
+	template <typename K>
+	size_t count(const K& key) const { return find_index(key) < m_members.size() ? 1 : 0; }
+
+	template <typename K, typename V>
+	std::pair<iterator, bool> emplace(K&& key, V&& value) { return insert(std::forward<K>(key), std::forward<V>(value), false); }
+	template <typename K, typename V>
+	std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) { return insert(std::forward<K>(key), std::forward<V>(value), true); }
+	// operator[] std::mapͬkeyʱһnull
+	template <typename K>
+	Json& operator[](K&& key) { return insert(std::forward<K>(key), Json(), false).first->second; }
+
+	template <typename K>
+	size_t erase(const K& key) {
+		const size_t k = find_index(key);
+		if (k == m_members.size()) return 0;
+		erase(m_members.cbegin() + k);
+		return 1;
+	}
+	iterator erase(const_iterator pos) {
+		const iterator next = m_members.erase(pos);
+		const size_t k = next - m_members.begin();
+		invalidate_index();
+		return m_members.begin() + k;
+	}
+
+	friend bool operator== (const JsonObject& lhs, const JsonObject& rhs) { return lhs.m_members == rhs.m_members; }
+	friend bool operator!= (const JsonObject& lhs, const JsonObject& rhs) { return !(lhs == rhs); }
+	friend bool operator< (const JsonObject& lhs, const JsonObject& rhs) {
+		return std::lexicographical_compare(lhs.m_members.begin(), lhs.m_members.end(), rhs.m_members.begin(), rhs.m_members.end());
+	}
+};
+
+};
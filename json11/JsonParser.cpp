@@ -1,40 +1,244 @@
 #include "JsonValue.h"
+#include "JsonArena.h"
+#include "JsonScanner.h"
+#include "JsonError.h"
+#include "JsonKeyTable.h"
+#include "JsonPathFilter.h"
+#include "JsonPolicy.h"
+#include "JsonParserContext.h"
+#include <algorithm>
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <type_traits>
 
 namespace json11 {
-/* JsonParser 
+/* BasicJsonParser<Policy>
  * 
- * ʵֽstringJsonValueĹ
+ * ʵֽstringJsonĹ
+ * Policyܵ﷨JsonPolicy.hеѡǱڳҪļ鲻ɵĴ
+ * JsonParserΪʹJsonDefaultPolicyBasicJsonParserJsonĴ󲿷ֽӿڶͨ
  */
-class JsonParser final {
+template <typename Policy>
+class BasicJsonParser final {
 private:
-	const std::string& str; // ʾҪstring
+	const std::string_view str; // ʾҪstringһڴ棬жȡԽstr.size()
 	size_t i; // ʾstrָ룬ʼʱΪ0
-	std::string& err; // ڼ¼stringзĴ
+	JsonError& error; // ڼ¼stringзĵһֻ¼λã
 	bool has_fail; // ¼ǰJsonParserڽǷ˴󣬳ʼʱΪfalse
-	const int max_depth; // JsonObjectеJsonValueǶ׵Ƕײι࣬Ҫߣmax_depthǶײ
+	const int max_depth; // JsonObjectеJsonǶ׵max_depthǶײΣĬΪPolicy::max_depth
+	JsonParserContext local_context; // ûдʱʹõģֻڱνʹ
+	JsonParserContext& context; // νʹõģµݴռ䶼еĳԱһν
+	std::shared_ptr<JsonArena> arena; // ARENAģʽнڵ㹲õڴأSTANDARDģʽΪ
+	std::shared_ptr<const void> owner; // IN_SITUģʽstrߣStringRefValue֤ͨstrᱻǰͷţΪʱʹIN_SITU
+	json11::JsonArray& value_stack; // DomHandlerݴδֵʱһƶСǡõJsonArray/JsonObjectУvector
+	std::vector<ObjectKey>& key_stack; // DomHandlerݴδļvalue_stackһһӦ
+	JsonKeyTable* key_table; // INTERN_KEYSģʽפõıΪ
+	// key_cacheΪֹļĹϣֵΪkey_cache_size / 2飬ÿλ¼һλɵļ
+	// ظļֱӹͬһڴ棬Ҳٷkey_tableҪС̶
+	// ARENAģʽ⣬ͬһĽĶĵ֮ҲЩ
+	std::vector<ObjectKey>& key_cache;
+	static constexpr size_t key_cache_size = 256;
+	// Container ΪһδcountΪѾɵԪأֵԣ
+	struct Container {
+		bool is_object;
+		size_t count;
+	};
+	/* ContainerStack
+	 *
+	 * parse_events()δݹʱĵջ
+	 * ǰinline_capacityֱӱJsonParserڲǶ׸ʱʹöϵoverflow
+	 * max_depthjson11::default_max_depthʱջڴ
+	 */
+	class ContainerStack {
+	private:
+		static constexpr size_t inline_capacity = std::min(Policy::max_depth, json11::default_max_depth) + 1;
+		Container items[inline_capacity];
+		std::vector<Container> overflow;
+		size_t count = 0;
+	public:
+		bool empty() const { return count == 0; }
+		size_t size() const { return count; }
+		void clear() {
+			count = 0;
+			overflow.clear();
+		}
+		void push_back(Container container) {
+			if (count < inline_capacity) items[count] = container;
+			else overflow.push_back(container);
+			++count;
+		}
+		void pop_back() {
+			if (count > inline_capacity) overflow.pop_back();
+			--count;
+		}
+		Container& back() { return count > inline_capacity ? overflow.back() : items[count - 1]; }
+	};
+	ContainerStack containers;
+	std::string& scratch; // תַַ뵽scratchУparse_string_view()ʹ
+	std::vector<uint32_t>& indexes; // JsonScannerɵĽṹΪʱֽհ׺ע
+	size_t next_index; // indexesһδʹõ
+	size_t index_end; // indexesǵķΧΪ[ʼλ, index_end)һΧֽڽ
+	static constexpr size_t index_threshold = 512; // 볤ȲСindex_thresholdʱֵɽṹ
+	bool check_utf8; // ǷַΪϷUTF-8VALIDATE_UTF8ģʽvalidate()ʱ򿪣Policy::validate_utf8ΪtrueʱǼ飩
 public:
-	JsonParser(const std::string& str_v, size_t i_v, std::string& err_v) 
-		: str(str_v), i(i_v), err(err_v), has_fail(false), max_depth(200){}
-	JsonParser(const std::string& str_v, std::string& err_v) 
-		: JsonParser(str_v, 0, err_v){}
+	// context_vΪʱʹJsonParserԼģʹcontext_vеݴռ䣬ͬһͬһʱֻܱһJsonParserʹ
+	BasicJsonParser(std::string_view str_v, size_t i_v, JsonError& error_v, JsonParseMode mode = STANDARD,
+					int max_depth_v = Policy::max_depth, std::shared_ptr<const void> owner_v = nullptr,
+					JsonParserContext* context_v = nullptr) 
+		: str(str_v), i(i_v), error(error_v), has_fail(false), max_depth(max_depth_v),
+		  context(context_v ? *context_v : local_context),
+		  arena(mode & ARENA ? context.acquire_arena() : nullptr),
+		  owner(mode & IN_SITU ? std::move(owner_v) : nullptr),
+		  value_stack(context.value_stack), key_stack(context.key_stack),
+		  key_table(mode & INTERN_KEYS ? &JsonKeyTable::global() : nullptr), key_cache(context.key_cache),
+		  scratch(context.scratch), indexes(context.indexes),
+		  next_index(0), index_end(0), check_utf8((mode & VALIDATE_UTF8) != 0) {
+		context.prepare_key_cache(mode);
+		value_stack.clear();
+		key_stack.clear();
+		indexes.clear();
+	}
+	BasicJsonParser(std::string_view str_v, JsonError& error_v, JsonParseMode mode = STANDARD,
+					int max_depth_v = Policy::max_depth, std::shared_ptr<const void> owner_v = nullptr,
+					JsonParserContext* context_v = nullptr) 
+		: BasicJsonParser(str_v, 0, error_v, mode, max_depth_v, std::move(owner_v), context_v){}
+	BasicJsonParser(const BasicJsonParser&) = delete;
+	BasicJsonParser& operator= (const BasicJsonParser&) = delete;
+	// ʱͷݴջвĽڵ㣻ARENAģʽ»ļڱĵarenaУҲһͷţʹĵarenaԱ
+	~BasicJsonParser() {
+		value_stack.clear();
+		key_stack.clear();
+		if (arena) context.clear_key_cache();
+	}
 private:
-	/* FormatChar()
-	*
-	* charcʽΪstringĸʽ
-	* ΪʲôҪô
-	* УerrĸҪͨ err += "Ϣ" + charʾģcharΪ̳ʱָiַָ
-	* string֧䣬ڴҪcahrתΪstringʽŻ
-	*/
-	inline std::string FormatChar(char c) {
-		char buf[12];
-		if (static_cast<uint8_t>(c) >= 0x20 && static_cast<uint8_t>(c) <= 0x7f) {
-			snprintf(buf, sizeof buf, "'%c' (%d)", c, c);
-		} else {
-			snprintf(buf, sizeof buf, "(%d)", c);
+	/* DomHandler
+	 *
+	 * parse_events()¼װΪJsonparse()parse_multi()ͨʵ
+	 * ֵѹvalue_stackʱٴջȡcountֵԼcountArrayValue/ObjectValue
+	 */
+	class DomHandler {
+	private:
+		BasicJsonParser& parser;
+
+		bool push(Json&& value) {
+			parser.value_stack.push_back(std::move(value));
+			return true;
 		}
-		return std::string(buf);
+	public:
+		explicit DomHandler(BasicJsonParser& parser_v) : parser(parser_v) {}
+
+		bool on_null() { return push(Json()); }
+		bool on_bool(bool value) { return push(Json(value)); }
+		bool on_number(double value) { return push(Json(value)); }
+		bool on_int64(int64_t value) { return push(Json(value)); }
+		bool on_uint64(uint64_t value) { return push(Json(value)); }
+		bool on_string(std::string_view value) {
+			// ֱַӱJsonڲȷڵ㣨뻺
+			if (value.size() <= Json::short_string_capacity) return push(Json(value));
+			// IN_SITUģʽ£valueֱָstrַûתַʱstr
+			const std::string_view str = parser.str;
+			if (parser.owner && value.data() >= str.data() && value.data() < str.data() + str.size()) {
+				return push(parser.make_value<StringRefValue>(parser.owner, value));
+			}
+			return push(parser.make_value<StringValue>(std::string(value)));
+		}
+		bool on_key(std::string_view key) {
+			parser.key_stack.push_back(parser.make_key(key));
+			return true;
+		}
+		bool on_start_array() { return true; }
+		bool on_end_array(size_t count) {
+			json11::JsonArray& values = parser.value_stack;
+			json11::JsonArray data(std::make_move_iterator(values.end() - count), std::make_move_iterator(values.end()));
+			values.resize(values.size() - count);
+			return push(parser.make_value<ArrayValue>(std::move(data)));
+		}
+		bool on_start_object() { return true; }
+		bool on_end_object(size_t count) {
+			json11::JsonArray& values = parser.value_stack;
+			std::vector<ObjectKey>& keys = parser.key_stack;
+			std::vector<json11::JsonObject::value_type> members;
+			members.reserve(count);
+			for (size_t k = keys.size() - count, v = values.size() - count; k < keys.size(); ++k, ++v) {
+				members.emplace_back(std::move(keys[k]), std::move(values[v]));
+			}
+			keys.erase(keys.end() - count, keys.end());
+			values.resize(values.size() - count);
+			// Ա˳УʱظļPolicy::duplicate_keys
+			Json data;
+			return parser.make_object(std::move(members), data) && push(std::move(data));
+		}
+	};
+
+	/* ValidateHandler
+	 *
+	 * validate()ʹõhandler¼
+	 * parse_events()ʱַparse_string()ֱӶread_string()
+	 */
+	struct ValidateHandler {
+		bool on_null() { return true; }
+		bool on_bool(bool) { return true; }
+		bool on_number(double) { return true; }
+		bool on_int64(int64_t) { return true; }
+		bool on_uint64(uint64_t) { return true; }
+		bool on_string(std::string_view) { return true; }
+		bool on_key(std::string_view) { return true; }
+		bool on_start_array() { return true; }
+		bool on_end_array(size_t) { return true; }
+		bool on_start_object() { return true; }
+		bool on_end_object(size_t) { return true; }
+	};
+
+	// NullOutput std::stringparse_string()ĽдֱӶ
+	struct NullOutput {
+		void operator+= (char) {}
+		void append(const char*, const char*) {}
+	};
+
+	/* make_value()
+	 *
+	 * һV͵Ľڵ㣨ַ󣩣ָJson
+	 * ARENAģʽ½ڵarenaУnew
+	 */
+	template <typename V, typename... Args>
+	Json make_value(Args&&... args) {
+		return Json::make<V>(arena, std::forward<Args>(args)...);
+	}
+
+	/* make_key()
+	 *
+	 * ļֱ̼ӱObjectKeyڲ
+	 * ͬһνͨkey_cacheͬһڴ棬ûʱINTERN_KEYSģʽkey_tableפARENAģʽ·arena
+	 */
+	ObjectKey make_key(std::string_view key) {
+		if (key.size() <= ObjectKey::inline_capacity) return ObjectKey(key);
+		if (key_cache.empty()) key_cache.resize(key_cache_size);
+		ObjectKey* const set = &key_cache[(std::hash<std::string_view>()(key) & (key_cache_size / 2 - 1)) * 2];
+		if (set[0].view() == key) return set[0];
+		if (set[1].view() == key) return set[1];
+		set[1] = std::move(set[0]);
+		set[0] = key_table ? key_table->intern(key)
+			: arena ? ObjectKey::allocate(key, ArenaAllocator<char>(arena))
+			: ObjectKey(key);
+		return set[0];
+	}
+
+	/* make_object()
+	 *
+	 * ɰ˳еmembersһԹظļPolicy::duplicate_keys
+	 * DUPLICATE_REJECTʱfalse¼󣬴λΪi - 1Ľ'}'
+	 */
+	bool make_object(std::vector<json11::JsonObject::value_type>&& members, Json& out) {
+		bool duplicate = false;
+		json11::JsonObject data = json11::JsonObject::from_unsorted(std::move(members), Policy::duplicate_keys == DUPLICATE_KEEP_LAST, &duplicate);
+		if (duplicate && Policy::duplicate_keys == DUPLICATE_REJECT) return fail(ERR_OBJECT_DUPLICATE_KEY, i - 1, false);
+		out = make_value<ObjectValue>(std::move(data));
+		return true;
 	}
 
 	/* in_range()
@@ -50,7 +254,8 @@ private:
 	*
 	* ptӦutf8ӵoutβ
 	*/
-	void encode_utf8(long pt, std::string& out) {
+	template <typename Out>
+	void encode_utf8(long pt, Out& out) {
 		if (pt < 0) return;
 		if (pt < 0x80) {
 			out += static_cast<char>(pt);
@@ -69,81 +274,99 @@ private:
 		}
 	}
 
+	/* flush_escaped()
+	 *
+	 * parse_string()δ\uתַpt뵽outβptΪ-1
+	 * UTF-8ʱûԵĴ0xD800-0xDFFFǺϷUTF-8ERR_STRING_INVALID_UTF8λposΪתַ'\\'
+	 */
+	template <typename Out>
+	bool flush_escaped(long& pt, size_t pos, Out& out) {
+		if (utf8_checked() && in_range(pt, 0xD800, 0xDFFF)) return fail(ERR_STRING_INVALID_UTF8, pos, false);
+		encode_utf8(pt, out);
+		pt = -1;
+		return true;
+	}
+
 	/* fail
 	 * 
-	 * ǵǰJsonParserΪfail״̬ͬʱerr ΪӦıϢ
+	 * ǵǰJsonParserΪfail״̬ͬʱerrorм¼codeַλpos
+	 * ﲻڴ棬ϢJsonError::message()Ҫʱ
 	 */
 	template <typename T>
-	T fail(std::string&& msg, const T err_ret) {
+	T fail(JsonErrorCode code, size_t pos, const T err_ret) {
 		if (!has_fail) {
-			err += "Ϣ" + std::move(msg) + ", λ: " + str.substr(i, 6);
+			error.set(code, str, pos);
 		}
 		has_fail = true;
 		return err_ret;
 	}
 
-	std::shared_ptr<JsonValue> fail(std::string&& msg) {
-		return fail(std::move(msg), json11::default_null);
-	}
-
 	/* consume_whitespace()
 	 *
 	 * ַĿհײ
 	 */
 	void consume_whitespace() {
-		while (str[i] == ' ' || str[i] == '\r' || str[i] == '\n' || str[i] == '\t')
-			++i;
+		const char* p = str.data() + i;
+		const char* const end = str.data() + str.size();
+		while (p != end && (*p == ' ' || *p == '\r' || *p == '\n' || *p == '\t'))
+			++p;
+		i = p - str.data();
 	}
 
 	/* consume_comment()
 	 *
 	 * ȷϵǰַǷΪע
-	 * עͣtrue򷵻falseerr
+	 * עͣtrue򷵻falseerrorм¼
 	 */
 	bool consume_comment() {
-		bool comment_found = false;
-		if (str[i] == '/') {
+		const char* p = str.data() + i;
+		const char* const end = str.data() + str.size();
+		if (p == end || *p != '/') return false;
+		const size_t comment_pos = i;
+		++p;
+		++i;
+		// ֻһ'/'
+		if (p == end)
+			return fail(ERR_COMMENT_INCOMPLETE, comment_pos, false);
+		// ע
+		if (*p == '/') {
+			const void* newline = std::memchr(p + 1, '\n', end - p - 1);
+			i = newline ? static_cast<const char*>(newline) - str.data() : str.size();
+			return true;
+		}
+		// ע
+		if (*p == '*') {
+			++p;
 			++i;
-			// ֻһ'/'
-			if (i == str.size())
-				return fail(R"(ֻһ/޷жǷΪע)", false);
-			// ע
-			if (str[i] == '/') {
-				++i;
-				while (i < str.size() && str[i] != '\n') ++i;
-				comment_found = true;
-			}
-			// ע
-			else if (str[i] == '*') {
-				++i;
-				// ڶעһΪ "/* ... */"ĸʽ
-				// עͳΪ4
-				// ǰ'*'± + 2  <= str.size() 
-				if (i > str.size() - 2)
-					return fail("עʹڴ", false);
-				// һֱֱҵ"*/"Ϊֹ
-				while (!(str[i] == '*' && str[i + 1] == '/')) {
-					++i;
-					if (i > str.size() - 2)
-						return fail("עʹڴ", false);
+			// ڶעһΪ "/* ... */"ĸʽһֱֱҵ"*/"Ϊֹ
+			while (end - p >= 2) {
+				if (p[0] == '*' && p[1] == '/') {
+					i = p + 2 - str.data();
+					return true;
 				}
-				i += 2;
-				comment_found = true;
-			}
-			// ȷǵעַͣǶע
-			else {
-				return fail(R"(עʹڴ)", false);
+				++p;
 			}
+			i = str.size();
+			return fail(ERR_COMMENT_UNTERMINATED, comment_pos, false);
 		}
-		return comment_found;
+		// ȷǵעַͣǶע
+		return fail(ERR_COMMENT_INVALID, comment_pos, false);
 	}
 
 	/* consume_garbage()
 	 *
-	 * עͺͿհ
+	 * עͺͿհףPolicy::allow_commentsΪfalseʱֻհ
 	 */
 	void consume_garbage() {
+		if (!indexes.empty()) {
+			// ṹ֤iһֻ֮пհףiǿհף˵tokenճһ truex߱
+			const size_t target = next_index < indexes.size() ? indexes[next_index] : index_end;
+			if (i < target && (str[i] == ' ' || str[i] == '\r' || str[i] == '\n' || str[i] == '\t'))
+				i = target;
+			if (i < index_end) return;
+		}
 		consume_whitespace();
+		if constexpr (!Policy::allow_comments) return;
 		bool comment_found = false;
 		do {
 			comment_found = consume_comment();
@@ -161,126 +384,264 @@ private:
 		consume_garbage();
 		if (has_fail) return static_cast<char>(0);
 		if (i == str.size())
-			return fail("stringĩβjson", static_cast<char>(0));
+			return fail(ERR_UNEXPECTED_END, i, static_cast<char>(0));
+		if (next_index < indexes.size() && i == indexes[next_index])
+			++next_index;
 		return str[i++];
 	}
 
+	/* build_index()
+	 *
+	 * 㹻ʱJsonScannerΪ[i, end)ɽṹ֮get_next_token()ת
+	 * дעʱJsonScannerfalseʱ˻ֽڽ
+	 */
+	void build_index(size_t end) {
+		index_end = std::min(end, str.size());
+		if (index_end < i || index_end - i < index_threshold || !JsonScanner::scan(str, i, index_end, indexes)) {
+			indexes.clear();
+		}
+		next_index = 0;
+	}
+
 	/* expect()
 	 *
 	 * striʼΪexpectedĳȣжһǷexpectedͬ
-	 * ͬ򷵻resͬ򷵻fail
+	 * ͬ򷵻trueͬ򷵻fail
 	 * Ҫڼnulltruefalse
 	 */
-	std::shared_ptr<JsonValue> expect(const std::string& expected, std::shared_ptr<JsonValue> res) {
+	bool expect(std::string_view expected) {
 		assert(i != 0);
 		--i;
-		if (str.compare(i, expected.length(), expected) == 0) {
-			i += expected.length();
-			return res;
+		if (str.size() - i >= expected.size() && std::memcmp(str.data() + i, expected.data(), expected.size()) == 0) {
+			i += expected.size();
+			return true;
 		} else {
-			return fail("parse error: expected " + expected + ", got " + str.substr(i, expected.length()));
+			return fail(ERR_INVALID_LITERAL, i, false);
 		}
 	}
 
-	std::shared_ptr<JsonValue> parse_number() {
-		size_t start_pos = i;
-	//
-		if (str[i] == '-') ++i;
+	/* parse_number()
+	 *
+	 * ڼָʽͬʱλۼЧ֣ٽstrtodɨһ飺
+	 * ûСָint64_tuint64_tΧڵȷؽhandleron_integer()תΪdouble
+	 * 19λЧûֱָuint64_tתõ
+	 * Чֲ2^53ʮָ22ֻһξȷĳ˳
+	 * ٳ֣Žstd::from_charsstrtodͬlocaleӰ
+	 * handlerfalseʱfalse
+	 */
+	template <typename Handler>
+	bool parse_number(Handler& handler) {
+		static constexpr double pow10[] = {
+			1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		const size_t start_pos = i;
+		const char* p = str.data() + i;
+		const char* const end = str.data() + str.size();
+		uint64_t mantissa = 0; // ۼӵõЧ
+		int digits = 0; // mantissaеЧָǰ0
+		int exponent = 0; // ʮָ
+		bool exact = true; // Чֳ19λʱmantissa޷¼ֻ·
+		auto add_digit = [&](char ch) {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + static_cast<uint64_t>(ch - '0');
+				if (mantissa != 0) ++digits;
+				return true;
+			}
+			exact = false;
+			return false;
+		};
+		auto is_digit = [&]() { return p != end && *p >= '0' && *p <= '9'; };
+		// λΪpһֹ淶ַ
+		auto number_fail = [&](JsonErrorCode code) {
+			i = p - str.data();
+			return fail(code, i, false);
+		};
+
+		const bool negative = (*p == '-');
+		if (negative) ++p;
+		bool integral = true; // ûСָ
 		//
-		if (str[i] == '0') {
-			++i;
-			if (in_range(str[i], '0', '9')) {
-				err += "0ֲֹ淶";
-				return json11::default_null;
+		if (p != end && *p == '0') {
+			++p;
+			if (is_digit()) {
+				return number_fail(ERR_NUMBER_LEADING_ZERO);
+			}
+		} else if (is_digit()) {
+			while (is_digit()) {
+				if (!add_digit(*p)) ++exponent;
+				++p;
 			}
-		} else if (in_range(str[i], '1', '9')) {
-			++i;
-			while (in_range(str[i], '0', '9')) ++i;
 		} else {
-			// err += "Ҫһλ" + FormatChar(str[i]);
-			err += "Ҫһλ";
-			err.push_back(str[i]);
-			has_fail = true;
-			return json11::default_null;
+			return number_fail(ERR_NUMBER_MISSING_DIGIT);
 		}
 		//
-		if (str[i] == '.') {
-			++i;
-			if (!in_range(str[i], '0', '9')) {
-				err += "С";
-				return json11::default_null;
+		if (p != end && *p == '.') {
+			++p;
+			integral = false;
+			if (!is_digit()) {
+				return number_fail(ERR_NUMBER_FRACTION);
+			}
+			while (is_digit()) {
+				if (add_digit(*p)) --exponent;
+				++p;
 			}
-			while (in_range(str[i], '0', '9')) ++i;
 		}
 		//
-		if (str[i] == 'e' || str[i] == 'E') {
-			++i;
-			if (str[i] == '+' || str[i] == '-') ++i;
-			if (!in_range(str[i], '0', '9')) {
-				err += "ָźҪһ";
-				return json11::default_null;
+		if (p != end && (*p == 'e' || *p == 'E')) {
+			++p;
+			integral = false;
+			bool exp_negative = false;
+			if (p != end && (*p == '+' || *p == '-')) exp_negative = (*p++ == '-');
+			if (!is_digit()) {
+				return number_fail(ERR_NUMBER_EXPONENT);
+			}
+			int exp_value = 0;
+			while (is_digit()) {
+				if (exp_value < 100000) exp_value = exp_value * 10 + (*p - '0');
+				++p;
 			}
-			while (in_range(str[i], '0', '9')) ++i;
+			exponent += exp_negative ? -exp_value : exp_value;
+		}
+		i = p - str.data();
+
+		// 19λʱmantissaľȷֵ20λֻпuint64_tΧڣ-0ȻǸ
+		if (integral) {
+			if (exact && !negative) return on_integer(handler, mantissa);
+			if (exact && mantissa != 0 && mantissa <= uint64_t(1) << 63) return on_integer(handler, static_cast<int64_t>(0 - mantissa));
+			uint64_t value;
+			if (!negative && std::from_chars(str.data() + start_pos, p, value).ec == std::errc()) return on_integer(handler, value);
 		}
-		double result = std::strtod(str.c_str() + start_pos, nullptr);
-		return std::make_shared<NumberValue>(result);
+
+		double result;
+		if (exact && exponent == 0) {
+			result = static_cast<double>(mantissa);
+		} else if (exact && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+			result = exponent < 0 ? static_cast<double>(mantissa) / pow10[-exponent]
+								  : static_cast<double>(mantissa) * pow10[exponent];
+		} else {
+			return handler_result(handler.on_number(parse_number_slow(start_pos, digits + exponent)));
+		}
+		return handler_result(handler.on_number(negative ? -result : result));
 	}
 
-	std::string parse_string() {
-		std::string out;
+	/* on_integer()
+	 *
+	 * õhandlerINT64_MAXĵon_int64()ĵon_uint64()
+	 * ӿǿѡģhandlerûṩʱתΪdoubleon_number()ԭеhandlerҪ޸
+	 */
+	template <typename Handler>
+	bool on_integer(Handler& handler, int64_t value) {
+		if constexpr (requires { handler.on_int64(value); }) {
+			return handler_result(handler.on_int64(value));
+		} else {
+			return handler_result(handler.on_number(static_cast<double>(value)));
+		}
+	}
+	template <typename Handler>
+	bool on_integer(Handler& handler, uint64_t value) {
+		if (value <= static_cast<uint64_t>(INT64_MAX)) return on_integer(handler, static_cast<int64_t>(value));
+		if constexpr (requires { handler.on_uint64(value); }) {
+			return handler_result(handler.on_uint64(value));
+		} else {
+			return handler_result(handler.on_number(static_cast<double>(value)));
+		}
+	}
+
+	/* parse_nan_inf()
+	 *
+	 * Policy::allow_nan_infΪtrueʱNaNInfinity-InfinitychΪѾȡĵһַ
+	 */
+	bool parse_nan_inf(char ch, double& out) {
+		if (ch == 'N') {
+			out = std::numeric_limits<double>::quiet_NaN();
+			return expect("NaN");
+		}
+		out = ch == '-' ? -HUGE_VAL : HUGE_VAL;
+		return expect(ch == '-' ? "-Infinity" : "Infinity");
+	}
+
+	/* parse_number_slow()
+	 *
+	 * std::from_charsstr[start_pos, i)
+	 * doubleΧʱfrom_charsдʱmagnitude0strtodһ£
+	 */
+	double parse_number_slow(size_t start_pos, int magnitude) {
+		double result = 0;
+		const std::from_chars_result res = std::from_chars(str.data() + start_pos, str.data() + i, result);
+		if (res.ec == std::errc::result_out_of_range) {
+			result = magnitude > 0 ? HUGE_VAL : 0.0;
+			if (str[start_pos] == '-') result = -result;
+		}
+		return result;
+	}
+
+	/* parse_string()
+	 *
+	 * iʼַʼ'"'ѱȡֱ'"'Ϊֹ
+	 * JsonScanner::find_string_special()һһַͨθƵout
+	 * ֻתַŻַʱ
+	 * ׷ӵoutβʱfalseOutΪNullOutputʱֻ鲻
+	 */
+	template <typename Out>
+	bool parse_string(Out& out) {
 		long last_escaped_codepoint = -1;
+		size_t last_escaped_pos = 0; // last_escaped_codepointתַstrеλ
 		while (true) {
+			const char* run_begin = str.data() + i;
+			const char* run_end = find_run_end(run_begin);
+			if (!run_end) return false;
+			if (run_end != run_begin) {
+				if (!flush_escaped(last_escaped_codepoint, last_escaped_pos, out)) return false;
+				out.append(run_begin, run_end);
+				i += run_end - run_begin;
+			}
+
 			if (i == str.length()) {
-				return fail("ַ", "");
+				return fail(ERR_STRING_UNTERMINATED, i, false);
 			}
 
 			char ch = str[i++];
 			// 
 			if (ch == '"') {
-				encode_utf8(last_escaped_codepoint, out);
-				return out;
+				return flush_escaped(last_escaped_codepoint, last_escaped_pos, out);
 			}
 			//
 			if (in_range(ch, 0, 0x1F)) {
-				return fail("ַгַ", FormatChar(ch));
-			}
-			//
-			if (ch != '\\') {
-				encode_utf8(last_escaped_codepoint, out);
-				last_escaped_codepoint = -1;
-				out += ch;
-				continue;
+				return fail(ERR_STRING_CONTROL_CHAR, i - 1, false);
 			}
-			//
+			// ʱchֻΪ'\\'
 			else {
 				if (i == str.length()) {
-					return fail("תִַ", "");
+					return fail(ERR_STRING_UNTERMINATED, i, false);
 				}
 				ch = str[i++];
 				//
 				if (ch == 'u') {
-					std::string esc = str.substr(i, 4);
-					if (esc.size() < 4) {
-						return fail(R"(\uַ)", "");
+					if (str.length() - i < 4) {
+						return fail(ERR_STRING_UNICODE_ESCAPE, i - 2, false);
 					}
+					long codepoint = 0;
 					for (size_t j = 0; j < 4; ++j) {
-						if (!in_range(esc[j], 'a', 'f') && !in_range(esc[j], 'A', 'F') && !in_range(esc[j], '0', '9')) {
-							return fail(R"(\uַ)", "");
-						}
+						const char hex = str[i + j];
+						if (in_range(hex, '0', '9')) codepoint = (codepoint << 4) | (hex - '0');
+						else if (in_range(hex, 'a', 'f')) codepoint = (codepoint << 4) | (hex - 'a' + 10);
+						else if (in_range(hex, 'A', 'F')) codepoint = (codepoint << 4) | (hex - 'A' + 10);
+						else return fail(ERR_STRING_UNICODE_ESCAPE, i - 2, false);
 					}
 
 					// last_escaped_codepointcodepointһѭʱlast_escaped_codepointڴunicodeдַ
 					// unicodeͨΪ16bitַҪ32bitunicodeͬʹ
 					//  \uD800\uDC00ʱӦ俴һַ\uD800DC00
 					// ĴԸĽΪһϴַΧַʱжһַЧʲ統ǰ
-					long codepoint = strtol(esc.data(), nullptr, 16);
 
 					if (in_range(last_escaped_codepoint, 0xD800, 0xDBFF) && in_range(codepoint, 0xDC00, 0xDFFF)) {
-						encode_utf8(((last_escaped_codepoint - 0xD800) << 10) | (codepoint - 0xDC00) + 0x10000, out);
+						encode_utf8((((last_escaped_codepoint - 0xD800) << 10) | (codepoint - 0xDC00)) + 0x10000, out);
 						last_escaped_codepoint = -1;
 					} else {
-						encode_utf8(last_escaped_codepoint, out);
+						if (!flush_escaped(last_escaped_codepoint, last_escaped_pos, out)) return false;
 						last_escaped_codepoint = codepoint;
+						last_escaped_pos = i - 2;
 					}
 
 					i += 4;
@@ -288,8 +649,7 @@ private:
 				}
 				//
 				else {
-					encode_utf8(last_escaped_codepoint, out);
-					last_escaped_codepoint = -1;
+					if (!flush_escaped(last_escaped_codepoint, last_escaped_pos, out)) return false;
 
 					if (ch == 'b') {
 						out += '\b';
@@ -304,114 +664,493 @@ private:
 					} else if (ch == '"' || ch == '\\' || ch == '/') {
 						out += ch;
 					} else {
-						return fail("ִתַ" + FormatChar(ch), "");
+						return fail(ERR_STRING_INVALID_ESCAPE, i - 2, false);
 					}
 				}
 			}
 		}
 	}
 
-	std::shared_ptr<JsonValue> parse_json(int depth) {
-		if (depth > max_depth) return fail("ι");
+	/* parse_string_view()
+	 *
+	 * iʼַʼ'"'ѱȡͨoutֻһνַ֮ǰЧ
+	 * ַûתַʱoutֱָstrƣ뵽scratchУoutָscratch
+	 */
+	bool parse_string_view(std::string_view& out) {
+		const char* begin = str.data() + i;
+		const char* end = find_run_end(begin);
+		if (!end) return false;
+		if (end != str.data() + str.size() && *end == '"') {
+			i += end - begin + 1;
+			out = std::string_view(begin, end - begin);
+			return true;
+		}
+		// һַ֮ǰַͨѾҵֱӸƣparse_string()ַ
+		scratch.assign(begin, end);
+		i += end - begin;
+		if (!parse_string(scratch)) return false;
+		out = scratch;
+		return true;
+	}
 
-		char ch = get_next_token();
-		if (has_fail) return json11::default_null;
+	// utf8_checked() Policy::validate_utf8ΪtrueʱǱڳ鲻·϶һη֧
+	bool utf8_checked() const { return Policy::validate_utf8 || check_utf8; }
 
-		if (ch == 'n') return expect("null", json11::default_null);
-		else if (ch == 't') return expect("true", default_true);
-		else if (ch == 'f') return expect("false", default_false);
-		else if (ch == '-' || (ch >= '0' && ch <= '9')) {
-			--i;
-			return parse_number();
+	/* find_run_end()
+	 *
+	 * ַдbeginʼһַͨĽλãһ'"''\\'ַJsonScanner::find_string_special()
+	 * ҪUTF-8ʱͬһɨм¼һǷзASCIIַֻкʱŽvalid_utf8()
+	 * һβǺϷUTF-8ʱؿգerrorм¼
+	 */
+	const char* find_run_end(const char* begin) {
+		const char* const str_end = str.data() + str.size();
+		if (!utf8_checked()) return JsonScanner::find_string_special(begin, str_end);
+		bool non_ascii = false;
+		const char* const end = JsonScanner::find_string_special(begin, str_end, non_ascii);
+		if (non_ascii && !valid_utf8(begin, end)) return nullptr;
+		return end;
+	}
+
+	/* valid_utf8()
+	 *
+	 * ַ[begin, end)һַͨǷΪϷUTF-8λΪһǷеʼֽ
+	 * һ'"''\\'ַΪ磬ֽеֽڶС0x80вԽ
+	 */
+	bool valid_utf8(const char* begin, const char* end) {
+		const char* invalid = JsonScanner::find_invalid_utf8(begin, end);
+		return invalid == end ? true : fail(ERR_STRING_INVALID_UTF8, invalid - str.data(), false);
+	}
+
+	/* read_string()
+	 *
+	 * parse_events()ȡַڣ֤ʱֻ鲻룬дscratchparse_string_view()ͬ
+	 */
+	template <typename Handler>
+	bool read_string(std::string_view& out) {
+		if constexpr (std::is_same_v<Handler, ValidateHandler>) {
+			NullOutput discard;
+			return parse_string(discard);
+		} else {
+			return parse_string_view(out);
 		}
-		else if (ch == '"')  return std::make_shared<StringValue>(parse_string());
-		else if (ch == '[') {
-			json11::JsonArray data;
-			ch = get_next_token();
-			//
-			if (ch == ']') {
-				return std::make_shared<ArrayValue>(data);
+	}
+
+	/* handler_result()
+	 *
+	 * handlerfalseʱֹ
+	 */
+	bool handler_result(bool ok) {
+		return ok ? true : fail(ERR_HANDLER_ABORTED, i, false);
+	}
+
+	/* parse_key()
+	 *
+	 * еһԼ':'chΪ֮ǰĵһЧַ
+	 * get_next_token()ȡchiѾһλ˴λΪi - 1
+	 */
+	template <typename Handler>
+	bool parse_key(Handler& handler, char ch) {
+		if (ch != '"') {
+			return fail(ERR_OBJECT_MISSING_KEY, i - 1, false);
+		}
+		std::string_view key;
+		if (!read_string<Handler>(key) || !handler_result(handler.on_key(key))) return false;
+		ch = get_next_token();
+		if (ch != ':') {
+			return fail(ERR_OBJECT_MISSING_COLON, i - 1, false);
+		}
+		return true;
+	}
+
+	/* parse_events()
+	 *
+	 * һֵεhandlerӦĽӿڣκJson
+	 * ʱon_end_array()/on_end_object()õԪأֵԣĸ
+	 * handlerĽӿڷfalseʱֹ
+	 *
+	 * δ¼containersжǵջϣǶײֻmax_depthƣᵼջ
+	 * ÿѭһֵ'[''{'ʱѹջеһֵ
+	 * ֵѾδ','ĽֱҪһֵĵ
+	 */
+	template <typename Handler>
+	bool parse_events(Handler& handler) {
+		containers.clear();
+		while (true) {
+			if (static_cast<int>(containers.size()) > max_depth) return fail(ERR_DEPTH_EXCEEDED, i, false);
+
+			char ch = get_next_token();
+			if (has_fail) return false;
+
+			if (ch == 'n') {
+				if (!expect("null") || !handler_result(handler.on_null())) return false;
 			}
-			while (true) {
+			else if (ch == 't') {
+				if (!expect("true") || !handler_result(handler.on_bool(true))) return false;
+			}
+			else if (ch == 'f') {
+				if (!expect("false") || !handler_result(handler.on_bool(false))) return false;
+			}
+			else if (Policy::allow_nan_inf && (ch == 'N' || ch == 'I' || (ch == '-' && i < str.size() && str[i] == 'I'))) {
+				double value;
+				if (!parse_nan_inf(ch, value) || !handler_result(handler.on_number(value))) return false;
+			}
+			else if (ch == '-' || (ch >= '0' && ch <= '9')) {
 				--i;
-				data.push_back(parse_json(depth + 1));
-				//
-				if (has_fail) {
-					return json11::default_null;
+				if (!parse_number(handler)) return false;
+			}
+			else if (ch == '"') {
+				std::string_view value;
+				if (!read_string<Handler>(value) || !handler_result(handler.on_string(value))) return false;
+			}
+			else if (ch == '[') {
+				if (!handler_result(handler.on_start_array())) return false;
+				ch = get_next_token();
+				if (has_fail) return false;
+				if (ch != ']') {
+					--i;
+					containers.push_back(Container{ false, 0 });
+					continue;
 				}
-
+				if (!handler_result(handler.on_end_array(0))) return false;
+			}
+			else if (ch == '{') {
+				if (!handler_result(handler.on_start_object())) return false;
 				ch = get_next_token();
-				if (ch == ']') break;
-				if (ch != ',') {
-					return  fail("ȱ\',\' " + FormatChar(ch));
+				if (has_fail) return false;
+				if (ch != '}') {
+					containers.push_back(Container{ true, 0 });
+					if (!parse_key(handler, ch)) return false;
+					continue;
 				}
+				if (!handler_result(handler.on_end_object(0))) return false;
+			}
+			else {
+				return fail(ERR_UNEXPECTED_CHAR, i - 1, false);
+			}
+
+			// һֵѾе','
+			while (true) {
+				if (containers.empty()) return true;
+				Container& top = containers.back();
+				++top.count;
 				ch = get_next_token();
+				if (has_fail) return false;
+				if (top.is_object) {
+					if (ch == '}') {
+						const size_t count = top.count;
+						containers.pop_back();
+						if (!handler_result(handler.on_end_object(count))) return false;
+						continue;
+					}
+					if (ch != ',') {
+						return fail(ERR_OBJECT_MISSING_COMMA, i - 1, false);
+					}
+					ch = get_next_token();
+					if (has_fail || !parse_key(handler, ch)) return false;
+				} else {
+					if (ch == ']') {
+						const size_t count = top.count;
+						containers.pop_back();
+						if (!handler_result(handler.on_end_array(count))) return false;
+						continue;
+					}
+					if (ch != ',') {
+						return fail(ERR_ARRAY_MISSING_COMMA, i - 1, false);
+					}
+					ch = get_next_token();
+					if (has_fail) return false;
+					--i;
+				}
+				break;
 			}
-			return std::make_shared<ArrayValue>(data);
 		}
+	}
 
-		else if (ch == '{') {
-			json11::JsonObject data;
-			ch = get_next_token();
-			if (ch == '}') {
-				return std::make_shared<ObjectValue>(data);
+	/* parse_json()
+	 *
+	 * ͨDomHandlerһֵJson
+	 */
+	Json parse_json() {
+		DomHandler handler(*this);
+		if (!parse_events(handler)) {
+			value_stack.clear();
+			key_stack.clear();
+			return Json();
+		}
+		Json result = std::move(value_stack.back());
+		value_stack.pop_back();
+		return result;
+	}
+
+	/* skip_string()
+	 *
+	 * iʼַʼ'"'ѱȡֻѰҽ'"'Ҳתַ
+	 */
+	bool skip_string() {
+		const char* p = str.data() + i;
+		const char* const end = str.data() + str.size();
+		while (true) {
+			p = JsonScanner::find_string_special(p, end);
+			if (p == end) break;
+			if (*p == '"') {
+				i = p + 1 - str.data();
+				return true;
 			}
-			while (true) {
-				if (ch != '"') {
-					return fail("ȱ '\"' " + FormatChar(ch));
+			p += (*p == '\\') ? 2 : 1;
+			if (p >= end) break;
+		}
+		i = str.size();
+		return fail(ERR_STRING_UNTERMINATED, i, false);
+	}
+
+	/* skip_value()
+	 *
+	 * һҪֵchΪֵĵһַѱȡκڴ
+	 * ֻŵĲβַе﷨нṹʱֱϼӴֵַ
+	 */
+	bool skip_value(char ch) {
+		if (ch != '[' && ch != '{') {
+			if (ch == '"') return skip_string();
+			if (!indexes.empty()) {
+				// һṹַ֮ǰֻi֮ͣǰget_next_token()
+				i = next_index < indexes.size() ? indexes[next_index] : index_end;
+				return true;
+			}
+			while (i < str.size() && std::strchr(",]} \t\r\n/", str[i]) == nullptr) ++i;
+			return true;
+		}
+		size_t depth = 1;
+		if (!indexes.empty()) {
+			while (next_index < indexes.size()) {
+				const size_t pos = indexes[next_index++];
+				const char c = str[pos];
+				if (c == '[' || c == '{') ++depth;
+				else if ((c == ']' || c == '}') && --depth == 0) {
+					i = pos + 1;
+					return true;
 				}
-				std::string key = parse_string();
-				if (has_fail) {
-					return json11::default_null;
+			}
+		} else {
+			while (i < str.size()) {
+				const char c = str[i++];
+				if (c == '"') {
+					if (!skip_string()) return false;
+				} else if (c == '[' || c == '{') {
+					++depth;
+				} else if (c == ']' || c == '}') {
+					if (--depth == 0) return true;
+				} else if (Policy::allow_comments && c == '/') {
+					--i;
+					if (!consume_comment()) return false;
 				}
-				ch = get_next_token();
-				if (ch != ':') {
-					return fail("ȱ ';' " + FormatChar(ch));
+			}
+		}
+		i = str.size();
+		return fail(ERR_UNEXPECTED_END, i, false);
+	}
+
+	/* parse_filtered()
+	 *
+	 * һֵֻfilternodeӦ·ϵĲֵ֣skip_value()
+	 * ݱѡʱouttrueûκݱѡлʧʱfalseʧʱhas_failΪtrue
+	 * nodeΪĳ·յʱֵparse_json()
+	 * ݹĲβfilter·ĲǶײ޹
+	 */
+	bool parse_filtered(const JsonPathFilter& filter, uint32_t node, int depth, Json& out) {
+		if (depth > max_depth) return fail(ERR_DEPTH_EXCEEDED, i, false);
+		if (filter.node(node).select) {
+			out = parse_json();
+			return !has_fail;
+		}
+		char ch = get_next_token();
+		if (has_fail) return false;
+		if (ch == '{') {
+			// ѡеĳԱȰ˳ռʱһԹDomHandler::on_end_object()ͬ
+			std::vector<json11::JsonObject::value_type> members;
+			ch = get_next_token();
+			while (!has_fail && ch != '}') {
+				if (ch != '"') return fail(ERR_OBJECT_MISSING_KEY, i - 1, false);
+				std::string_view key;
+				if (!parse_string_view(key)) return false;
+				const uint32_t child = filter.find(node, key);
+				// keyָscratchҪڽӽڵ֮ǰObjectKey
+				ObjectKey object_key = child != JsonPathFilter::npos ? make_key(key) : ObjectKey();
+				if (get_next_token() != ':') {
+					return has_fail ? false : fail(ERR_OBJECT_MISSING_COLON, i - 1, false);
 				}
-				data[std::move(key)] = parse_json(depth + 1);
-				if (has_fail) {
-					return json11::default_null;
+				if (child != JsonPathFilter::npos) {
+					Json value;
+					const bool selected = parse_filtered(filter, child, depth + 1, value);
+					if (has_fail) return false;
+					if (selected) members.emplace_back(std::move(object_key), std::move(value));
+				} else if (!skip_value(get_next_token())) {
+					return false;
 				}
 				ch = get_next_token();
-				if (ch == '}') break;
-				if (ch != ',') {
-					return fail("ȱ ',' " + FormatChar(ch));
+				if (ch == ',') ch = get_next_token();
+				else if (ch != '}' && !has_fail) return fail(ERR_OBJECT_MISSING_COMMA, i - 1, false);
+			}
+			if (has_fail || members.empty()) return false;
+			return make_object(std::move(members), out);
+		}
+		if (ch == '[') {
+			json11::JsonArray data;
+			ch = get_next_token();
+			for (size_t index = 0; !has_fail && ch != ']'; ++index) {
+				const uint32_t child = filter.find(node, index);
+				if (child != JsonPathFilter::npos) {
+					--i;
+					Json value;
+					const bool selected = parse_filtered(filter, child, depth + 1, value);
+					if (has_fail) return false;
+					if (selected) data.push_back(std::move(value));
+				} else if (!skip_value(ch)) {
+					return false;
 				}
 				ch = get_next_token();
+				if (ch == ',') ch = get_next_token();
+				else if (ch != ']' && !has_fail) return fail(ERR_ARRAY_MISSING_COMMA, i - 1, false);
 			}
-			return std::make_shared<ObjectValue>(data);
+			if (has_fail || data.empty()) return false;
+			out = make_value<ArrayValue>(std::move(data));
+			return true;
 		}
-
-		return fail("δ֪" + FormatChar(ch));
+		// ·ûнܱѡ
+		skip_value(ch);
+		return false;
 	}
 
 public:
 
-	std::shared_ptr<JsonValue> parse() {
-		std::shared_ptr<JsonValue> result = parse_json(0);
+	Json parse() {
+		build_index(str.size());
+		Json result = parse_json();
+		consume_garbage();
+		if (has_fail) return Json();
+		if (!Policy::allow_trailing_content && i != str.length()) {
+			return fail(ERR_TRAILING_CONTENT, i, Json());
+		}
+		return result;
+	}
+
+	/* parse(const JsonPathFilter& filter)
+	 *
+	 * parse()ֻͬfilterѡеĲ֣JsonPathFilter
+	 * ֵֻǷԣڲ﷨󲻻ᱻ
+	 */
+	Json parse(const JsonPathFilter& filter) {
+		build_index(str.size());
+		Json result;
+		parse_filtered(filter, 0, 0, result);
 		consume_garbage();
-		if (has_fail) return json11::default_null;
-		if (i != str.length()) {
-			return fail("unexpected trailing " + JsonParser::FormatChar(str[i]));
+		if (has_fail) return Json();
+		if (!Policy::allow_trailing_content && i != str.length()) {
+			return fail(ERR_TRAILING_CONTENT, i, Json());
 		}
 		return result;
 	}
 
-	std::vector<std::shared_ptr<JsonValue>> parse_multi() {
-		std::string::size_type parser_stop_pos = 0;
-		std::vector<std::shared_ptr<JsonValue>> jsonvalue_vec;
-		while (i != str.length() && !has_fail) {
-			std::shared_ptr<JsonValue> jv_ptr = parse_json(0);
-			jsonvalue_vec.push_back(jv_ptr);
+	std::vector<Json> parse_multi() {
+		return parse_multi(str.size());
+	}
+
+	/* parse_multi(size_t stop)
+	 *
+	 * iʼνĵֱĳĵĿհסעͣstop֮
+	 * һĵԽstopposition()õʵͣµλ
+	 * Json::parse_multi_parallel()ֶβн
+	 */
+	std::vector<Json> parse_multi(size_t stop) {
+		std::vector<Json> jsonvalue_vec;
+		build_index(stop);
+		while (i < stop && i != str.length() && !has_fail) {
+			jsonvalue_vec.push_back(parse_json());
 			if (has_fail) break;
 			
 			consume_garbage();
-			if (has_fail) break;
-
-			parser_stop_pos = i;
 		}
 		return jsonvalue_vec;
 	}
+
+	/* parse_value()
+	 *
+	 * ֻiʼһֵendΪֵĽλãһtokenʼλãͬʱ޶ṹķΧ
+	 * ֵendֻֿ֮հעͣΪERR_TRAILING_CONTENT 1falsenullz
+	 * JsonLazyȡĳֵʱֵֻͨ
+	 */
+	Json parse_value(size_t end) {
+		build_index(end);
+		Json result = parse_json();
+		if (has_fail || !finish_value(end)) return Json();
+		return result;
+	}
+
+	template <typename Handler>
+	bool parse_value(Handler& handler, size_t end) {
+		build_index(end);
+		return parse_events(handler) && finish_value(end);
+	}
+
+	// finish_value() parse_value()ֵ֮Ŀհעͣûеendʱ˵ֵ֮
+	bool finish_value(size_t end) {
+		consume_garbage();
+		if (has_fail) return false;
+		if (i < end) return fail(ERR_TRAILING_CONTENT, i, false);
+		return true;
+	}
+
+	/* validate()
+	 *
+	 * ֻstrǷΪһϷJsonĵ﷨עͣparse()ȫͬ⻹ҪַΪϷUTF-8
+	 * κֵַҲ룻ɽṹֽɨһ
+	 * max_depthjson11::default_max_depthʱ̲ڴ
+	 */
+	bool validate() {
+		check_utf8 = true;
+		ValidateHandler handler;
+		parse_events(handler);
+		consume_garbage();
+		if (has_fail) return false;
+		if (!Policy::allow_trailing_content && i != str.length()) {
+			return fail(ERR_TRAILING_CONTENT, i, false);
+		}
+		return true;
+	}
+
+	size_t position() const { return i; }
+	bool failed() const { return has_fail; }
+
+	/* parse_sax()
+	 *
+	 * strеһֵ¼ʽνhandlerJson
+	 * HandlerҪṩ½ӿڣһfalseʱֹ
+	 *   bool on_null();
+	 *   bool on_bool(bool value);
+	 *   bool on_number(double value);
+	 *   bool on_int64(int64_t value);    ѡûСָûʱon_number()
+	 *   bool on_uint64(uint64_t value);  ѡINT64_MAXûʱon_number()
+	 *   bool on_string(std::string_view value);
+	 *   bool on_key(std::string_view key);
+	 *   bool on_start_array();
+	 *   bool on_end_array(size_t count);
+	 *   bool on_start_object();
+	 *   bool on_end_object(size_t count);
+	 * on_string()on_key()õstring_viewֻڱεڼЧҪʱhandlerи
+	 */
+	template <typename Handler>
+	bool parse_sax(Handler& handler) {
+		build_index(str.size());
+		parse_events(handler);
+		consume_garbage();
+		if (has_fail) return false;
+		if (!Policy::allow_trailing_content && i != str.length()) {
+			return fail(ERR_TRAILING_CONTENT, i, false);
+		}
+		return true;
+	}
 };
 
-};
\ No newline at end of file
+// JsonParser ʹJsonDefaultPolicy﷨֮ǰJsonParserȫͬ
+using JsonParser = BasicJsonParser<JsonDefaultPolicy>;
+
+};
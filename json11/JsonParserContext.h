@@ -0,0 +1,143 @@
+#pragma once
+#include "json11_namespace.h"
+#include "JsonArena.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace json11 {
+/* JsonParserContext
+ *
+ * ڶν֮临õĽģJsonParserʹõݴռ䣬
+ * ֵݴջĻ桢ַõscratchṹԼARENAģʽµJsonArena
+ * ͬһСĵʱЩռֻνʱ䣬֮ٷڴ棨еĽڵ⣩
+ *
+ * ı̰߳ȫģͬһʱֻܱһJsonParserʹ
+ * ҪԼʱʹJsonParserContext::local()ӵǰ̵߳ĳȡһ
+ * Json::parse()parse_multi()parse_sax()ͨͬһ߳ĽԶͬһ
+ */
+class JsonParserContext final {
+private:
+	template <typename Policy>
+	friend class BasicJsonParser;
+
+	json11::JsonArray value_stack;
+	std::vector<ObjectKey> key_stack;
+	std::vector<ObjectKey> key_cache;
+	int key_cache_mode = 0; // key_cacheеļģʽARENAINTERN_KEYSģʽͬʱҪ
+	std::string scratch;
+	std::vector<uint32_t> indexes;
+	std::shared_ptr<JsonArena> arena;
+
+	/* arena_unused()
+	 *
+	 * жarenaǷֻĳУһνĵѾȫ
+	 * ĵȻʱڵ㹲ͬarenause_count()ܻص1˼жϲУ
+	 * use_count()ֻһrelaxedȡһڵ߳
+	 * жϳҪһacquireդǸ߳ͷʱreleaseԣʹarenaڴд븴
+	 */
+	bool arena_unused() const {
+		if (!arena || arena.use_count() != 1) return false;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return true;
+	}
+
+	/* acquire_arena()
+	 *
+	 * رνʹõJsonArenaarena_unused()ʱúã򴴽µarena
+	 */
+	std::shared_ptr<JsonArena> acquire_arena() {
+		if (arena_unused()) {
+			arena->reset();
+		} else {
+			arena = std::make_shared<JsonArena>();
+		}
+		return arena;
+	}
+
+	/* prepare_key_cache()
+	 *
+	 * ĴʽģʽͬINTERN_KEYSģʽJsonKeyTableARENAģʽ·ڸĵarenaУ
+	 * ģʽıʱջ棬ģʽͬʱļڲͬĵ֮
+	 */
+	void prepare_key_cache(int mode) {
+		const int key_mode = mode & (ARENA | INTERN_KEYS);
+		if (key_mode != key_cache_mode) {
+			clear_key_cache();
+			key_cache_mode = key_mode;
+		}
+	}
+
+	// clear_key_cache() ARENAģʽĽʱãļarenaͷŵĻĵarenaҲ޷
+	void clear_key_cache() {
+		for (ObjectKey& key : key_cache) key = ObjectKey();
+	}
+
+	static constexpr size_t retain_bytes = 1 << 20; // 黹̵߳ĳʱÿݴռౣֽ
+
+	// trim() ͷųretain_bytesݴռ䣬żһܴĵһֱռڴ
+	void trim() {
+		if (scratch.capacity() > retain_bytes) std::string().swap(scratch);
+		if (indexes.capacity() * sizeof(uint32_t) > retain_bytes) std::vector<uint32_t>().swap(indexes);
+		if (value_stack.capacity() * sizeof(value_stack[0]) > retain_bytes) json11::JsonArray().swap(value_stack);
+		if (key_stack.capacity() * sizeof(ObjectKey) > retain_bytes) std::vector<ObjectKey>().swap(key_stack);
+		// ĵȻʱarenaĵУĲٳУֻһڴ
+		if (arena_unused()) arena->reset();
+		else arena.reset();
+	}
+
+	// Pool Ϊһ̵߳ĳأֻ߳зʣҪ
+	using Pool = std::vector<std::unique_ptr<JsonParserContext>>;
+	static Pool& thread_pool() {
+		thread_local Pool pool;
+		return pool;
+	}
+
+public:
+	JsonParserContext() = default;
+	JsonParserContext(const JsonParserContext&) = delete;
+	JsonParserContext& operator= (const JsonParserContext&) = delete;
+
+	/* Lease
+	 *
+	 * ̵߳ĳнģʱ黹Ƕ׵ĽSAX handlerٴν赽ͬ
+	 * ֻڽ߳
+	 */
+	class Lease final {
+	private:
+		std::unique_ptr<JsonParserContext> context;
+	public:
+		explicit Lease(std::unique_ptr<JsonParserContext> context_v) : context(std::move(context_v)) {}
+		Lease(Lease&&) = default;
+		Lease& operator= (Lease&&) = delete;
+		~Lease() {
+			if (!context) return;
+			context->trim();
+			thread_pool().push_back(std::move(context));
+		}
+		JsonParserContext& operator* () const { return *context; }
+		JsonParserContext* operator-> () const { return context.get(); }
+	};
+
+	// local() ڴӵǰ̵߳ĳнһģΪʱµ
+	static Lease local() {
+		Pool& pool = thread_pool();
+		if (pool.empty()) return Lease(std::make_unique<JsonParserContext>());
+		std::unique_ptr<JsonParserContext> context = std::move(pool.back());
+		pool.pop_back();
+		return Lease(std::move(context));
+	}
+
+	// clear() ͷеݴռ
+	void clear() {
+		json11::JsonArray().swap(value_stack);
+		std::vector<ObjectKey>().swap(key_stack);
+		std::vector<ObjectKey>().swap(key_cache);
+		std::string().swap(scratch);
+		std::vector<uint32_t>().swap(indexes);
+		arena.reset();
+	}
+};
+
+};
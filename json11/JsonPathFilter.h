@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json11 {
+/* JsonPathFilter
+ *
+ * Json::parse()·ֻλЩ·ϵֵᱻΪJsonֵڽʱֱ
+ * ·дJSON PointerRFC 6901ͬ"/user/id""/items/0/price""~1"ʾ'/'"~0"ʾ'~'
+ * ·еһΪ"*"ʱƥееԪأ·""ʾĵ'/'ͷ·Ϊʡ˿ͷ'/'
+ *
+ * ֻͨѡֵֻƥļֻƥԪأԭ˳У±겻ԭĵӦ
+ * ĳûκƥʱҲڽУĵûƥʱΪnull
+ *
+ * ·ڹʱϲΪһǰ׺ͬһԷڽĵ
+ */
+class JsonPathFilter final {
+public:
+	static constexpr uint32_t npos = 0; // ڵ0Ϊڵ㣬κνڵӽڵ㣬0ʾڵӽڵ
+
+	// Node Ϊǰ׺еһڵ㣬Ӧ·еһ
+	struct Node {
+		bool select = false; // ڵ㱾ĳ·յ㣬µҪ
+		std::map<std::string, uint32_t, std::less<>> children; // ±ʮдƥӽڵ
+		uint32_t wildcard = npos; // "*"Ӧӽڵ
+	};
+
+private:
+	std::vector<Node> nodes;
+
+	uint32_t child(uint32_t node, std::string_view key) {
+		const auto it = nodes[node].children.find(key);
+		if (it != nodes[node].children.end()) return it->second;
+		nodes.emplace_back();
+		const uint32_t created = static_cast<uint32_t>(nodes.size() - 1);
+		nodes[node].children.emplace(std::string(key), created);
+		return created;
+	}
+
+	uint32_t wildcard_child(uint32_t node) {
+		if (nodes[node].wildcard == npos) {
+			nodes.emplace_back();
+			nodes[node].wildcard = static_cast<uint32_t>(nodes.size() - 1);
+		}
+		return nodes[node].wildcard;
+	}
+
+	// unescape() ԭ·һ"~1""~0"
+	static std::string unescape(std::string_view token) {
+		std::string out;
+		for (size_t k = 0; k < token.size(); ++k) {
+			if (token[k] == '~' && k + 1 < token.size() && (token[k + 1] == '0' || token[k + 1] == '1')) {
+				out += token[++k] == '0' ? '~' : '/';
+			} else {
+				out += token[k];
+			}
+		}
+		return out;
+	}
+
+	// merge() srcµ·ϲdst
+	void merge(uint32_t dst, uint32_t src) {
+		if (nodes[src].select) nodes[dst].select = true;
+		const std::vector<std::pair<std::string, uint32_t>> src_children(nodes[src].children.begin(), nodes[src].children.end());
+		for (const auto& item : src_children) {
+			merge(child(dst, item.first), item.second);
+		}
+		if (nodes[src].wildcard != npos) merge(wildcard_child(dst), nodes[src].wildcard);
+	}
+
+	/* resolve()
+	 *
+	 * ĳͬʱƥӽڵ"*"ʱѡеݶҪ
+	 * ˽"*"µ·ϲÿӽڵУʱÿֻһӽڵ
+	 */
+	void resolve(uint32_t node) {
+		const uint32_t wildcard = nodes[node].wildcard;
+		std::vector<uint32_t> children;
+		for (const auto& item : nodes[node].children) children.push_back(item.second);
+		for (const uint32_t c : children) {
+			if (wildcard != npos) merge(c, wildcard);
+			resolve(c);
+		}
+		if (wildcard != npos) resolve(wildcard);
+	}
+
+	void add(std::string_view path) {
+		uint32_t node = 0;
+		if (!path.empty() && path[0] == '/') path.remove_prefix(1);
+		else if (path.empty()) {
+			nodes[0].select = true;
+			return;
+		}
+		while (true) {
+			const size_t slash = path.find('/');
+			const std::string_view token = path.substr(0, slash);
+			node = token == "*" ? wildcard_child(node) : child(node, unescape(token));
+			if (slash == std::string_view::npos) break;
+			path.remove_prefix(slash + 1);
+		}
+		nodes[node].select = true;
+	}
+
+public:
+	JsonPathFilter(std::initializer_list<std::string_view> paths) : nodes(1) {
+		for (const std::string_view path : paths) add(path);
+		resolve(0);
+	}
+	explicit JsonPathFilter(const std::vector<std::string>& paths) : nodes(1) {
+		for (const std::string& path : paths) add(path);
+		resolve(0);
+	}
+
+	const Node& node(uint32_t n) const { return nodes[n]; }
+
+	// find() nodeмkeyӦӽڵ㣬ûƥʱnpos
+	uint32_t find(uint32_t node, std::string_view key) const {
+		const Node& n = nodes[node];
+		const auto it = n.children.find(key);
+		return it != n.children.end() ? it->second : n.wildcard;
+	}
+
+	// find() node±indexӦӽڵ㣬ûƥʱnpos
+	uint32_t find(uint32_t node, size_t index) const {
+		const Node& n = nodes[node];
+		if (n.children.empty()) return n.wildcard;
+		return find(node, std::string_view(std::to_string(index)));
+	}
+};
+
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include "json11_namespace.h"
+
+namespace json11 {
+
+// ʾгظļʱĴʽ
+enum JsonDuplicateKeys {
+	DUPLICATE_KEEP_LAST = 0,	// һγֵֵΪ׼
+	DUPLICATE_KEEP_FIRST,		// ԵһγֵֵΪ׼
+	DUPLICATE_REJECT			// ERR_OBJECT_DUPLICATE_KEY
+};
+
+/* 
+ *
+ * BasicJsonParser<Policy>ģʱܵ﷨ѡǱڳ
+ *   allow_commentsǷעͣΪfalseʱconsume_garbage()жע͵ļᱻ
+ *   max_depthmax_depthĬֵjson11::default_max_depthʱջڴ
+ *   duplicate_keysгظļʱĴʽֻӰ칹JsonĽӿڣparse_sax()handlerյм
+ *   allow_nan_infǷNaNInfinity-Infinity
+ *   validate_utf8ǷҪַΪϷUTF-8
+ *   allow_trailing_contentparse()һֵ֮Ƿݣݱԣ
+ *
+ * ԶԿԼ̳ĳԣֻҪ޸ĵѡ
+ */
+
+// JsonDefaultPolicy ΪJson::parse()Ƚӿһֱ﷨עͣRFC 8259ͬ
+struct JsonDefaultPolicy {
+	static constexpr bool allow_comments = true;
+	static constexpr int max_depth = json11::default_max_depth;
+	static constexpr JsonDuplicateKeys duplicate_keys = DUPLICATE_KEEP_LAST;
+	static constexpr bool allow_nan_inf = false;
+	static constexpr bool validate_utf8 = false;
+	static constexpr bool allow_trailing_content = false;
+};
+
+// JsonStrictPolicy ϸRFC 8259עַͣΪϷUTF-8
+struct JsonStrictPolicy : JsonDefaultPolicy {
+	static constexpr bool allow_comments = false;
+	static constexpr bool validate_utf8 = true;
+};
+
+// JsonPermissivePolicy JsonDefaultPolicyĻϽNaNInfinityԼĵ֮
+struct JsonPermissivePolicy : JsonDefaultPolicy {
+	static constexpr bool allow_nan_inf = true;
+	static constexpr bool allow_trailing_content = true;
+};
+
+};
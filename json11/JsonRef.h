@@ -0,0 +1,84 @@
+#pragma once
+#include "Json11.h"
+
+namespace json11 {
+/* JsonRef
+ *
+ * ָĵĳֵֻͼֻһָ룬ֵ뷵
+ * ·ңref["a"][1]["b"]ʱJsonıκüҲκιĿɱ״̬
+ * ˶߳̿ͬʱͬһĵ繲ã
+ *
+ * Json::operator[]ͬҲֵһڵJsonRefexists()ֵΪnullĳԱ֣
+ * ڵJsonRefϵķʽӿnullͬ
+ * JsonRefĵֻڱõJsonڼЧ˲ʱJson죻Ҫʱto_json()
+ */
+class JsonRef final {
+private:
+	const Json* m_json; // Ϊʱʾһڵֵ
+
+public:
+	JsonRef() noexcept : m_json(nullptr) {}
+	JsonRef(const Json& json) noexcept : m_json(&json) {}
+	JsonRef(Json&&) = delete;
+
+	// exists() жϵǰֵǷڣoperator[]ҲӦԪʱزڵֵ
+	bool exists() const { return m_json != nullptr; }
+
+	// json() ڷرõJsonʱnull
+	const Json& json() const { return m_json ? *m_json : null_json(); }
+
+	json11::JsonType type() const { return json().type(); }
+	bool is_null()   const { return type() == NUL; }
+	bool is_bool()   const { return type() == BOOL; }
+	bool is_number() const { return type() == NUMBER; }
+	bool is_string() const { return type() == STRING; }
+	bool is_array()  const { return type() == ARRAY; }
+	bool is_object() const { return type() == OBJECT; }
+
+	bool bool_value() const { return json().bool_value(); }
+	int int_value() const { return json().int_value(); }
+	int64_t int64_value() const { return json().int64_value(); }
+	uint64_t uint64_value() const { return json().uint64_value(); }
+	double number_value() const { return json().number_value(); }
+	std::string string_value() const { return json().string_value(); }
+	std::string_view string_view_value() const { return json().string_view_value(); }
+	const JsonArray& array_items() const { return json().array_items(); }
+	const JsonObject& object_items() const { return json().object_items(); }
+
+	// size() ڷԪظļֵԸͷ0
+	size_t size() const {
+		if (!m_json) return 0;
+		return m_json->is_array() ? m_json->array_items().size() : m_json->object_items().size();
+	}
+
+	JsonRef operator[](size_t i) const {
+		if (!m_json) return JsonRef();
+		const JsonArray& items = m_json->array_items();
+		return i < items.size() ? JsonRef(items[i]) : JsonRef();
+	}
+	JsonRef operator[](std::string_view key) const { return find(key); }
+	JsonRef operator[](const JsonKey& key) const { return find(key); }
+	JsonRef get(const ObjectKey& key) const { return find(key); }
+
+	void dump(std::string& out) const { json().dump(out); }
+	std::string dump() const { return json().dump(); }
+
+	// to_json() ڸƳǰֵԭֵڵ㣩ʱnull
+	Json to_json() const { return json(); }
+
+private:
+	static const Json& null_json() {
+		static const Json null_value;
+		return null_value;
+	}
+
+	template <typename K>
+	JsonRef find(const K& key) const {
+		if (!m_json) return JsonRef();
+		const JsonObject& items = m_json->object_items();
+		const auto it = items.find(key);
+		return it != items.end() ? JsonRef(it->second) : JsonRef();
+	}
+};
+
+};
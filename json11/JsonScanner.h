@@ -0,0 +1,568 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define JSON11_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(JSON11_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JSON11_SSE2 1
+#endif
+
+#if defined(JSON11_X86) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define JSON11_AVX2 1
+#define JSON11_SSSE3 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define JSON11_TARGET_AVX2
+#define JSON11_TARGET_SSSE3
+#else
+#define JSON11_TARGET_AVX2 __attribute__((target("avx2")))
+#define JSON11_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#endif
+
+namespace json11 {
+
+/* JsonScanner
+ *
+ * JsonParserĵһ׶Σ64ֽΪһз࣬ɽṹ
+ * ṹа˳¼ַ֮ÿһtokenʼλã
+ * ṹַ { } [ ] : , ַʼţԼ֡truefalsenullĵһַ
+ * ڶ׶ΣJsonParser::get_next_tokenֱһλãֽհ
+ *
+ * ÿһķSSE2/AVX2ɣʱCPUѡ񣩣ƽ̨˻Ϊֽڵıʵ
+ * ת塢ַж64λɣָ޹
+ *
+ * ⻹ṩַݵɨ裨find_string_specialUTF-8飨find_invalid_utf8JsonParserַʹ
+ */
+class JsonScanner final {
+private:
+	// BlockMasks Ϊһ64ֽиַλ룬nλӦеnֽ
+	struct BlockMasks {
+		uint64_t quote;			// '"'
+		uint64_t backslash;		// '\\'
+		uint64_t op;			// { } [ ] : ,
+		uint64_t whitespace;	// ' ' '\t' '\n' '\r'
+		uint64_t slash;			// '/'ַ˵ע
+	};
+
+	using ClassifyFn = void (*)(const char* block, BlockMasks& masks);
+
+	static void classify_scalar(const char* block, BlockMasks& masks) {
+		masks = BlockMasks{ 0, 0, 0, 0, 0 };
+		for (int n = 0; n < 64; ++n) {
+			const uint64_t bit = uint64_t(1) << n;
+			switch (block[n]) {
+			case '"': masks.quote |= bit; break;
+			case '\\': masks.backslash |= bit; break;
+			case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+			case ' ': case '\t': case '\n': case '\r': masks.whitespace |= bit; break;
+			case '/': masks.slash |= bit; break;
+			default: break;
+			}
+		}
+	}
+
+#ifdef JSON11_SSE2
+	static void classify_sse2(const char* block, BlockMasks& masks) {
+		masks = BlockMasks{ 0, 0, 0, 0, 0 };
+		for (int n = 0; n < 4; ++n) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * n));
+			auto eq = [&v](char c) { return _mm_cmpeq_epi8(v, _mm_set1_epi8(c)); };
+			auto bits = [](__m128i m) { return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(m))); };
+			const __m128i op = _mm_or_si128(_mm_or_si128(_mm_or_si128(eq('{'), eq('}')), _mm_or_si128(eq('['), eq(']'))),
+											_mm_or_si128(eq(':'), eq(',')));
+			const __m128i ws = _mm_or_si128(_mm_or_si128(eq(' '), eq('\t')), _mm_or_si128(eq('\n'), eq('\r')));
+			masks.quote |= bits(eq('"')) << (16 * n);
+			masks.backslash |= bits(eq('\\')) << (16 * n);
+			masks.op |= bits(op) << (16 * n);
+			masks.whitespace |= bits(ws) << (16 * n);
+			masks.slash |= bits(eq('/')) << (16 * n);
+		}
+	}
+#endif
+
+#ifdef JSON11_AVX2
+	JSON11_TARGET_AVX2
+	static void classify_avx2(const char* block, BlockMasks& masks) {
+		masks = BlockMasks{ 0, 0, 0, 0, 0 };
+		for (int n = 0; n < 2; ++n) {
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32 * n));
+			const __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+			const __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+			const __m256i slash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('/'));
+			const __m256i op = _mm256_or_si256(
+				_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('}'))),
+								_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(']')))),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+			const __m256i ws = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+			masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(quote))) << (32 * n);
+			masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(backslash))) << (32 * n);
+			masks.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << (32 * n);
+			masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(ws))) << (32 * n);
+			masks.slash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(slash))) << (32 * n);
+		}
+	}
+
+	static bool cpu_has_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+#ifdef JSON11_SSSE3
+	static bool cpu_has_ssse3() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 9)) != 0;
+#else
+		return __builtin_cpu_supports("ssse3");
+#endif
+	}
+#endif
+
+	/* find_invalid_utf8_scalar()
+	 *
+	 * find_invalid_utf8()м飬ASCIIַÿμ8ֽڣλΪ1ֽʱм
+	 */
+	static const char* find_invalid_utf8_scalar(const char* p, const char* end) {
+		while (p != end) {
+			while (end - p >= 8) {
+				uint64_t w;
+				std::memcpy(&w, p, 8);
+				if (w & 0x8080808080808080ULL) break;
+				p += 8;
+			}
+			if (p == end) break;
+			const uint8_t c = static_cast<uint8_t>(*p);
+			if (c < 0x80) {
+				++p;
+				continue;
+			}
+			// nΪֽ[lo, hi]ΪһֽڵĺϷΧ
+			int n;
+			uint8_t lo = 0x80, hi = 0xBF;
+			if (c >= 0xC2 && c <= 0xDF) n = 1;
+			else if (c == 0xE0) { n = 2; lo = 0xA0; }
+			else if (c == 0xED) { n = 2; hi = 0x9F; }
+			else if (c >= 0xE1 && c <= 0xEF) n = 2;
+			else if (c == 0xF0) { n = 3; lo = 0x90; }
+			else if (c == 0xF4) { n = 3; hi = 0x8F; }
+			else if (c >= 0xF1 && c <= 0xF3) n = 3;
+			else return p;
+			if (end - p <= n) return p;
+			const uint8_t c1 = static_cast<uint8_t>(p[1]);
+			if (c1 < lo || c1 > hi) return p;
+			for (int k = 2; k <= n; ++k) {
+				if ((static_cast<uint8_t>(p[k]) & 0xC0) != 0x80) return p;
+			}
+			p += n + 1;
+		}
+		return end;
+	}
+
+	/* UTF-8Ĳ飨Keiser & Lemire"Validating UTF-8 In Less Than One Instruction Per Byte"
+	 *
+	 * ÿֽǰ1~3ֽһ飺ǰһֽڵĸ4λ4λԼǰֽڵĸ4λֱ
+	 * λ֮Ϊ0˵ڶӦĴ󣨹̡롢ԡU+10FFFF
+	 * ǰ23ֽжϵǰֽǷΪ34ֽеĺֽ
+	 * pshufbһ16ֽڣҪSSSE316ֽһ飩AVX232ֽһ飩
+	 */
+	static constexpr uint8_t UTF8_TOO_SHORT = 1 << 0;		// 11______ 0_______  11______ 11______
+	static constexpr uint8_t UTF8_TOO_LONG = 1 << 1;		// 0_______ 10______
+	static constexpr uint8_t UTF8_OVERLONG_3 = 1 << 2;		// 11100000 100_____
+	static constexpr uint8_t UTF8_TOO_LARGE = 1 << 3;		// 11110100 1001____ 
+	static constexpr uint8_t UTF8_SURROGATE = 1 << 4;		// 11101101 101_____
+	static constexpr uint8_t UTF8_OVERLONG_2 = 1 << 5;		// 1100000_ 10______
+	static constexpr uint8_t UTF8_TOO_LARGE_1000 = 1 << 6;	// 11110101 1000____ 
+	static constexpr uint8_t UTF8_OVERLONG_4 = 1 << 6;		// 11110000 1000____
+	static constexpr uint8_t UTF8_TWO_CONTS = 1 << 7;		// 10______ 10______
+	static constexpr uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+	// ű_mm_setr_epi8Ĳ˳У±ΪӦ4λ
+	static constexpr uint8_t utf8_byte_1_high[16] = {
+		UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+		UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+		UTF8_TOO_SHORT,
+		UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+		UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+	};
+	static constexpr uint8_t utf8_byte_1_low[16] = {
+		UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+		UTF8_CARRY | UTF8_OVERLONG_2,
+		UTF8_CARRY,
+		UTF8_CARRY,
+		UTF8_CARRY | UTF8_TOO_LARGE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+		UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+	};
+	static constexpr uint8_t utf8_byte_2_high[16] = {
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+		UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+	};
+
+	using Utf8Fn = const char* (*)(const char* p, const char* end);
+
+#ifdef JSON11_SSSE3
+	JSON11_TARGET_SSSE3
+	static __m128i utf8_block_errors_ssse3(__m128i input, __m128i prev_input) {
+		const __m128i low_nibble = _mm_set1_epi8(0x0F);
+		const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+		const __m128i byte_1_high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_high)),
+													 _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+		const __m128i byte_1_low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_low)),
+													_mm_and_si128(prev1, low_nibble));
+		const __m128i byte_2_high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_2_high)),
+													 _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+		const __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+		// ǰ2ֽΪ111_____ǰ3ֽΪ1111____ʱǰֽڱǺֽڣspecial_casesеUTF8_TWO_CONTS໥
+		const __m128i is_third_byte = _mm_subs_epu8(_mm_alignr_epi8(input, prev_input, 14), _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m128i is_fourth_byte = _mm_subs_epu8(_mm_alignr_epi8(input, prev_input, 13), _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m128i must23_80 = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)));
+		return _mm_xor_si128(must23_80, special_cases);
+	}
+
+	/* utf8_blocks_ssse3() / utf8_blocks_avx2()
+	 *
+	 * 16/32ֽΪһ[p, end)һĲ֣Ϊգ0Ϊһ飬
+	 * ˱endضϵҲᱻֽ֣λ0
+	 * ȫϷʱؿգ򷵻صһдĿʼλãܵend
+	 * ֤߱pһֽем䣻еĴԴǰһĩβУfind_invalid_utf8()¶λ
+	 */
+	JSON11_TARGET_SSSE3
+	static const char* utf8_blocks_ssse3(const char* p, const char* end) {
+		__m128i prev_input = _mm_setzero_si128();
+		char tail[16];
+		while (true) {
+			const bool last = end - p < 16;
+			const char* block = p;
+			if (last) {
+				std::memset(tail, 0, sizeof tail);
+				std::memcpy(tail, p, end - p);
+				block = tail;
+			}
+			const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+			if ((_mm_movemask_epi8(input) | _mm_movemask_epi8(prev_input)) != 0) {
+				const __m128i errors = utf8_block_errors_ssse3(input, prev_input);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) != 0xFFFF) return p;
+			}
+			if (last) return nullptr;
+			prev_input = input;
+			p += 16;
+		}
+	}
+
+#endif
+
+#ifdef JSON11_AVX2
+	JSON11_TARGET_AVX2
+	static __m256i utf8_block_errors_avx2(__m256i input, __m256i prev_input) {
+		const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+		// prev_n Ϊinputƶnֽڡճλprev_inputĩβ
+		const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+		const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+		const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+		const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+		// 128λͨԲ˱ͨиһ
+		const __m256i table_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_high)));
+		const __m256i table_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_1_low)));
+		const __m256i table_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(utf8_byte_2_high)));
+		const __m256i byte_1_high = _mm256_shuffle_epi8(table_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+		const __m256i byte_1_low = _mm256_shuffle_epi8(table_1_low, _mm256_and_si256(prev1, low_nibble));
+		const __m256i byte_2_high = _mm256_shuffle_epi8(table_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+		const __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+		const __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+		const __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+		const __m256i must23_80 = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+		return _mm256_xor_si256(must23_80, special_cases);
+	}
+
+	JSON11_TARGET_AVX2
+	static const char* utf8_blocks_avx2(const char* p, const char* end) {
+		__m256i prev_input = _mm256_setzero_si256();
+		char tail[32];
+		while (true) {
+			const bool last = end - p < 32;
+			const char* block = p;
+			if (last) {
+				std::memset(tail, 0, sizeof tail);
+				std::memcpy(tail, p, end - p);
+				block = tail;
+			}
+			const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+			if ((_mm256_movemask_epi8(input) | _mm256_movemask_epi8(prev_input)) != 0) {
+				const __m256i errors = utf8_block_errors_avx2(input, prev_input);
+				if (!_mm256_testz_si256(errors, errors)) return p;
+			}
+			if (last) return nullptr;
+			prev_input = input;
+			p += 32;
+		}
+	}
+#endif
+
+	/* utf8_blocks()
+	 *
+	 * ʱѡutf8_blocks_avx2()utf8_blocks_ssse3()߶֧ʱؿգֻʹеļ
+	 */
+	static Utf8Fn utf8_blocks() {
+		static const Utf8Fn fn = []() -> Utf8Fn {
+#ifdef JSON11_AVX2
+			if (cpu_has_avx2()) return utf8_blocks_avx2;
+#endif
+#ifdef JSON11_SSSE3
+			if (cpu_has_ssse3()) return utf8_blocks_ssse3;
+#endif
+			return nullptr;
+		}();
+		return fn;
+	}
+
+	/* classifier()
+	 *
+	 * ʱCPUֵָ֧ѡຯֻڵһεʱ
+	 */
+	static ClassifyFn classifier() {
+		static const ClassifyFn fn = []() -> ClassifyFn {
+#ifdef JSON11_AVX2
+			if (cpu_has_avx2()) return classify_avx2;
+#endif
+#ifdef JSON11_SSE2
+			return classify_sse2;
+#else
+			return classify_scalar;
+#endif
+		}();
+		return fn;
+	}
+
+	static inline int trailing_zeros(uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+		unsigned long n;
+		_BitScanForward64(&n, x);
+		return static_cast<int>(n);
+#elif defined(_MSC_VER) && !defined(__clang__)
+		unsigned long n;
+		if (_BitScanForward(&n, static_cast<unsigned long>(x))) return static_cast<int>(n);
+		_BitScanForward(&n, static_cast<unsigned long>(x >> 32));
+		return static_cast<int>(n) + 32;
+#else
+		return __builtin_ctzll(x);
+#endif
+	}
+
+	/* prefix_xor()
+	 *
+	 * nλΪx0λnλλõõַڲķΧ
+	 */
+	static inline uint64_t prefix_xor(uint64_t x) {
+		x ^= x << 1;
+		x ^= x << 2;
+		x ^= x << 4;
+		x ^= x << 8;
+		x ^= x << 16;
+		x ^= x << 32;
+		return x;
+	}
+
+	/* find_escaped()
+	 *
+	 * رбתַλãprev_escaped¼һһַǷΪδתķб
+	 * бڴ󲿷кٳֱ֣Ӱλ
+	 */
+	static inline uint64_t find_escaped(uint64_t backslash, uint64_t& prev_escaped) {
+		uint64_t escaped = prev_escaped;
+		backslash &= ~prev_escaped;
+		prev_escaped = 0;
+		while (backslash) {
+			const int n = trailing_zeros(backslash);
+			if (n == 63) {
+				prev_escaped = 1;
+				break;
+			}
+			escaped |= uint64_t(1) << (n + 1);
+			backslash &= ~(uint64_t(3) << n);
+		}
+		return escaped;
+	}
+
+public:
+	/* find_string_special()
+	 *
+	 * pʼҵһ '"''\\' ַ< 0x20Ҳ򷵻end
+	 * JsonParser::parse_string()ַַ֮ͨһθ
+	 * ÿμ16ֽڣSSE28ֽڣִһĲֽڼ
+	 * non_asciiİ汾ͬһɨм¼ԽַǷзASCIIַ>= 0x80ûʱټUTF-8
+	 */
+	static const char* find_string_special(const char* p, const char* end) {
+		return find_special<false>(p, end, nullptr);
+	}
+
+	static const char* find_string_special(const char* p, const char* end, bool& non_ascii) {
+		return find_special<true>(p, end, &non_ascii);
+	}
+
+private:
+	template <bool TrackNonAscii>
+	static const char* find_special(const char* p, const char* end, bool* non_ascii) {
+		uint64_t high = 0; // ԽַλΪ1ֽڣֻTrackNonAsciiʱ¼
+#ifdef JSON11_SSE2
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x1F);
+		while (end - p >= 16) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+												 _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+			const int mask = _mm_movemask_epi8(special);
+			if constexpr (TrackNonAscii) {
+				// specialλֽ֮ڲһ
+				high |= static_cast<uint64_t>(_mm_movemask_epi8(v) & (mask ? (mask & -mask) - 1 : 0xFFFF));
+			}
+			if (mask) {
+				if constexpr (TrackNonAscii) *non_ascii = high != 0;
+				return p + trailing_zeros(static_cast<uint64_t>(mask));
+			}
+			p += 16;
+		}
+#else
+		const uint64_t ones = 0x0101010101010101ULL;
+		const uint64_t highs = 0x8080808080808080ULL;
+		while (end - p >= 8) {
+			uint64_t w;
+			std::memcpy(&w, p, 8);
+			const uint64_t q = w ^ (ones * '"');
+			const uint64_t b = w ^ (ones * '\\');
+			// ĳһֽΪ0С0x20ʱӦֽڵλ1
+			const uint64_t special = ((q - ones) & ~q) | ((b - ones) & ~b) | ((w - ones * 0x20) & ~w);
+			if (special & highs) break;
+			if constexpr (TrackNonAscii) high |= w & highs;
+			p += 8;
+		}
+#endif
+		while (p != end && *p != '"' && *p != '\\' && static_cast<uint8_t>(*p) >= 0x20) {
+			if constexpr (TrackNonAscii) high |= static_cast<uint8_t>(*p) & 0x80;
+			++p;
+		}
+		if constexpr (TrackNonAscii) *non_ascii = high != 0;
+		return p;
+	}
+
+public:
+
+	/* find_invalid_utf8()
+	 *
+	 * [p, end)ǷΪϷUTF-8صһǷеʼλãȫϷʱend
+	 * 롢ԣU+D800~U+DFFFU+10FFFFԼendضϵоΪǷ
+	 * ͷASCIIַÿμ8ֽڣASCIIַʣಿutf8_blocks()飬
+	 * ֻвִʱŴӳм飬ȷ׼ȷλã֧SSSE3ƽ̨ȫм
+	 */
+	static const char* find_invalid_utf8(const char* p, const char* end) {
+		static const Utf8Fn blocks = utf8_blocks();
+		while (end - p >= 8) {
+			uint64_t w;
+			std::memcpy(&w, p, 8);
+			if (w & 0x8080808080808080ULL) break;
+			p += 8;
+		}
+		if (blocks && p != end) {
+			// p֮ǰASCIIpһеĿʼĿ֮صеĿʼ
+			const char* const checked = blocks(p, end);
+			if (!checked) return end;
+			if (checked != p) {
+				p = checked;
+				for (int k = 0; k < 3 && (static_cast<uint8_t>(p[-1]) & 0xC0) == 0x80; ++k) --p;
+				if (static_cast<uint8_t>(p[-1]) >= 0xC0) --p;
+			}
+		}
+		return find_invalid_utf8_scalar(p, end);
+	}
+
+	/* scan()
+	 *
+	 * ɨstr[start, end)ݣṹ˳дindexes
+	 * ַⷢ'/'עͣfalseɵ˻صֽڽ
+	 */
+	static bool scan(std::string_view str, size_t start, size_t end, std::vector<uint32_t>& indexes) {
+		indexes.clear();
+		if (str.size() > UINT32_MAX) return false;
+		indexes.reserve((end - start) / 8);
+
+		const ClassifyFn classify = classifier();
+		uint64_t prev_escaped = 0;		// һĩβǷΪδתķб
+		uint64_t prev_in_string = 0;	// һĩβǷַڲȫ1ȫ0
+		uint64_t prev_scalar = 0;		// һһַǷΪ֡trueȱtokenһ
+
+		char tail[64];
+		for (size_t pos = start; pos < end; pos += 64) {
+			const char* block = str.data() + pos;
+			if (end - pos < 64) {
+				// 64ֽڵĲԿհײ
+				std::memset(tail, ' ', sizeof tail);
+				std::memcpy(tail, block, end - pos);
+				block = tail;
+			}
+
+			BlockMasks masks;
+			classify(block, masks);
+
+			const uint64_t escaped = find_escaped(masks.backslash, prev_escaped);
+			const uint64_t quote = masks.quote & ~escaped;
+			// in_string ʼţ
+			const uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+			prev_in_string = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+			if (masks.slash & ~in_string) return false;
+
+			// ַıtokenֻ¼һַ
+			const uint64_t scalar = ~(masks.op | masks.whitespace);
+			const uint64_t nonquote_scalar = scalar & ~quote;
+			const uint64_t follows_scalar = (nonquote_scalar << 1) | prev_scalar;
+			prev_scalar = nonquote_scalar >> 63;
+			const uint64_t string_tail = in_string ^ quote;
+			uint64_t structurals = (masks.op | (scalar & ~follows_scalar)) & ~string_tail;
+
+			while (structurals) {
+				indexes.push_back(static_cast<uint32_t>(pos + trailing_zeros(structurals)));
+				structurals &= structurals - 1;
+			}
+		}
+		return true;
+	}
+};
+
+};
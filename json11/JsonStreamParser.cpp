@@ -0,0 +1,302 @@
+#include "JsonStreamParser.h"
+
+namespace json11 {
+
+JsonStreamParser::JsonStreamParser(std::string& err_v, int max_depth_v)
+	: err(err_v), has_fail(false), max_depth(max_depth_v), lex_state(IDLE), expect(VALUE), escaped(false), offset(0),
+	  token_offset(0), line(1), line_start(0) {}
+
+/* fail
+ *
+ * ǵǰJsonStreamParserΪfail״̬parse_errorм¼еλposͬʱerr
+ * ֮ǰĿѾкÿʱۼƵlineline_startϵǰpos֮ǰĻеõ
+ * posڵǰ֮ǰʱ˵λڿtokenڲtokenвֻУ
+ */
+bool JsonStreamParser::fail(JsonErrorCode code, size_t pos) {
+	if (!has_fail) {
+		size_t error_line = line, error_line_start = line_start;
+		for (size_t p = offset; p < pos && p - offset < chunk.size(); ++p) {
+			if (chunk[p - offset] == '\n') {
+				++error_line;
+				error_line_start = p + 1;
+			}
+		}
+		parse_error.code = code;
+		parse_error.offset = pos;
+		parse_error.line = error_line;
+		parse_error.column = pos - error_line_start + 1;
+		err += parse_error.message();
+	}
+	has_fail = true;
+	return false;
+}
+
+/* unexpected
+ *
+ * pos˲ϵǰ﷨״̬tokenѡ
+ */
+bool JsonStreamParser::unexpected(size_t pos) {
+	switch (expect) {
+	case KEY:
+	case KEY_OR_END:
+		return fail(ERR_OBJECT_MISSING_KEY, pos);
+	case COLON:
+		return fail(ERR_OBJECT_MISSING_COLON, pos);
+	case COMMA_OR_END:
+		return fail(stack.back().is_object ? ERR_OBJECT_MISSING_COMMA : ERR_ARRAY_MISSING_COMMA, pos);
+	default:
+		return fail(ERR_UNEXPECTED_CHAR, pos);
+	}
+}
+
+Json JsonStreamParser::next_document() {
+	Json result = std::move(documents.front());
+	documents.pop_front();
+	return result;
+}
+
+/* finish_token()
+ *
+ * ǰtokenѾJsonParser룬õֵٽ﷨״̬
+ */
+bool JsonStreamParser::finish_token() {
+	JsonError token_error;
+	JsonParser parser(token, token_error);
+	Json value = parser.parse();
+	lex_state = IDLE;
+	if (token_error) {
+		return fail(token_error.code, token_offset + token_error.offset);
+	}
+	// ַڼλʱΪļ
+	if (value.is_string() && (expect == KEY || expect == KEY_OR_END)) {
+		stack.back().key = value.string_value();
+		expect = COLON;
+		return true;
+	}
+	if (static_cast<int>(stack.size()) > max_depth) {
+		return fail(ERR_DEPTH_EXCEEDED, token_offset);
+	}
+	return on_value(std::move(value));
+}
+
+/* on_value()
+ *
+ * һֵ뵱ǰκʱ˵һĵѾ
+ * ǰλòֵʱλΪֵtokenʼλtoken_offset
+ */
+bool JsonStreamParser::on_value(Json value) {
+	if (expect != VALUE && expect != VALUE_OR_END) {
+		return unexpected(token_offset);
+	}
+	if (stack.empty()) {
+		documents.push_back(std::move(value));
+		expect = VALUE;
+		return true;
+	}
+	Frame& top = stack.back();
+	if (top.is_object) {
+		top.members.emplace_back(ObjectKey(top.key), std::move(value));
+	} else {
+		top.array.push_back(std::move(value));
+	}
+	expect = COMMA_OR_END;
+	return true;
+}
+
+/* on_punct()
+ *
+ *  [ ] { } , : Ƚṹַ
+ */
+bool JsonStreamParser::on_punct(char ch, size_t pos) {
+	if (ch == '[' || ch == '{') {
+		if (expect != VALUE && expect != VALUE_OR_END) {
+			return unexpected(pos);
+		}
+		// JsonParser::parse_events()ͬʼһֵʱѾ򿪵ܳmax_depth
+		if (static_cast<int>(stack.size()) > max_depth) {
+			return fail(ERR_DEPTH_EXCEEDED, pos);
+		}
+		stack.push_back(Frame{ ch == '{', {}, {}, {} });
+		expect = ch == '{' ? KEY_OR_END : VALUE_OR_END;
+		return true;
+	}
+	if (ch == ']' || ch == '}') {
+		const bool is_object = (ch == '}');
+		if (stack.empty() || stack.back().is_object != is_object
+			|| (expect != COMMA_OR_END && expect != (is_object ? KEY_OR_END : VALUE_OR_END))) {
+			return unexpected(pos);
+		}
+		// ĳԱڽʱһظļһγֵΪ׼
+		Json value = is_object ? Json(JsonObject::from_unsorted(std::move(stack.back().members))) : Json(std::move(stack.back().array));
+		stack.pop_back();
+		expect = VALUE;
+		return on_value(std::move(value));
+	}
+	if (ch == ',') {
+		if (expect != COMMA_OR_END) {
+			return unexpected(pos);
+		}
+		expect = stack.back().is_object ? KEY : VALUE;
+		return true;
+	}
+	if (ch == ':') {
+		if (expect != COLON) {
+			return unexpected(pos);
+		}
+		expect = VALUE;
+		return true;
+	}
+	return fail(ERR_UNEXPECTED_CHAR, pos);
+}
+
+bool JsonStreamParser::feed(const char* data, size_t len) {
+	const char* p = data;
+	const char* const end = data + len;
+	chunk = std::string_view(data, len);
+	while (p != end && !has_fail) {
+		const size_t pos = offset + (p - data);
+		switch (lex_state) {
+		case IDLE: {
+			const char ch = *p;
+			if (ch == ' ' || ch == '\r' || ch == '\n' || ch == '\t') {
+				++p;
+			} else if (ch == '/') {
+				lex_state = SLASH;
+				++p;
+			} else if (ch == '"') {
+				token.assign(1, ch);
+				token_offset = pos;
+				escaped = false;
+				lex_state = IN_STRING;
+				++p;
+			} else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+				token.assign(1, ch);
+				token_offset = pos;
+				lex_state = IN_NUMBER;
+				++p;
+			} else if (ch >= 'a' && ch <= 'z') {
+				token.assign(1, ch);
+				token_offset = pos;
+				lex_state = IN_LITERAL;
+				++p;
+			} else {
+				on_punct(ch, pos);
+				++p;
+			}
+			break;
+		}
+		case IN_STRING: {
+			if (escaped) {
+				token += *p++;
+				escaped = false;
+				break;
+			}
+			// θֱַͨ '"''\\' ַ
+			const char* run_end = JsonScanner::find_string_special(p, end);
+			token.append(p, run_end);
+			p = run_end;
+			if (p == end) break;
+			const char ch = *p++;
+			token += ch;
+			if (ch == '\\') {
+				escaped = true;
+			} else if (ch == '"') {
+				finish_token();
+			} else {
+				fail(ERR_STRING_CONTROL_CHAR, offset + (p - data) - 1);
+			}
+			break;
+		}
+		case IN_NUMBER:
+		case IN_NUMBER_FRAC:
+		case IN_NUMBER_EXP: {
+			// JsonParser::parse_number()ͬСָ˳ȡ˳ַ֮ڵǰ
+			const char ch = *p;
+			const char last = token.back();
+			bool more = (ch >= '0' && ch <= '9');
+			if (ch == '.' && lex_state == IN_NUMBER) {
+				lex_state = IN_NUMBER_FRAC;
+				more = true;
+			} else if ((ch == 'e' || ch == 'E') && lex_state != IN_NUMBER_EXP) {
+				lex_state = IN_NUMBER_EXP;
+				more = true;
+			} else if ((ch == '+' || ch == '-') && (last == 'e' || last == 'E')) {
+				more = true;
+			}
+			if (more) {
+				token += ch;
+				++p;
+			} else {
+				// ǰַtokentokenIDLE״̬´ǰַ
+				finish_token();
+			}
+			break;
+		}
+		case IN_LITERAL: {
+			// JsonParser::expect()ͬtruenullȡ4ַfalseȡ5ַ
+			const size_t length = token[0] == 'f' ? 5 : 4;
+			if (*p >= 'a' && *p <= 'z') {
+				token += *p++;
+				if (token.size() == length) finish_token();
+			} else {
+				finish_token();
+			}
+			break;
+		}
+		case SLASH: {
+			if (*p == '/') lex_state = LINE_COMMENT;
+			else if (*p == '*') lex_state = BLOCK_COMMENT;
+			else fail(ERR_COMMENT_INVALID, pos - 1);
+			++p;
+			break;
+		}
+		case LINE_COMMENT: {
+			if (*p == '\n') lex_state = IDLE;
+			++p;
+			break;
+		}
+		case BLOCK_COMMENT:
+		case BLOCK_COMMENT_STAR: {
+			if (*p == '/' && lex_state == BLOCK_COMMENT_STAR) lex_state = IDLE;
+			else lex_state = (*p == '*') ? BLOCK_COMMENT_STAR : BLOCK_COMMENT;
+			++p;
+			break;
+		}
+		}
+	}
+	// ۼһеĻУ֮Ŀ鱨ʱɴ˼к
+	for (const char* nl = data; nl != end && (nl = static_cast<const char*>(std::memchr(nl, '\n', end - nl))) != nullptr; ++nl) {
+		++line;
+		line_start = offset + (nl - data) + 1;
+	}
+	chunk = std::string_view();
+	offset += len;
+	return !has_fail;
+}
+
+bool JsonStreamParser::finish() {
+	if (has_fail) return false;
+	switch (lex_state) {
+	case IN_NUMBER:
+	case IN_NUMBER_FRAC:
+	case IN_NUMBER_EXP:
+	case IN_LITERAL:
+		if (!finish_token()) return false;
+		break;
+	case IN_STRING:
+		return fail(ERR_STRING_UNTERMINATED, offset);
+	case SLASH:
+		return fail(ERR_COMMENT_INCOMPLETE, offset - 1);
+	case BLOCK_COMMENT:
+	case BLOCK_COMMENT_STAR:
+		return fail(ERR_COMMENT_UNTERMINATED, offset);
+	default:
+		break;
+	}
+	if (!stack.empty() || expect != VALUE) {
+		return fail(ERR_UNEXPECTED_END, offset);
+	}
+	return true;
+}
+
+};
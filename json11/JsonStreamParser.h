@@ -0,0 +1,93 @@
+#pragma once
+#include "Json11.h"
+#include <deque>
+
+namespace json11 {
+/* JsonStreamParser
+ *
+ * Էֿʽ
+ * ÿfeed()ⳤȵһݣ״ַ̬֡תַע͵м״̬feed()֮䱣
+ * ÿһJsonĵͽdocumentsУhas_document()next_document()ȡ
+ * JsonParser::parse_multi()һпγֶĵ
+ *
+ * ڲֻ浱ǰδһtokenַֻtrue/false/nulltokenJsonParser룬
+ * tokenĺϷԼJsonParserȫһ£Ƕ׹ϵʽջstack¼
+ */
+class JsonStreamParser final {
+private:
+	// ʷ״̬ǰtokenһ
+	enum LexState {
+		IDLE,				// λtoken֮
+		IN_STRING,			// ַڲ
+		IN_NUMBER,			// ֵ
+		IN_NUMBER_FRAC,		// ֵС
+		IN_NUMBER_EXP,		// ֵָ
+		IN_LITERAL,			// truefalsenullڲ
+		SLASH,				// עͿͷ'/'
+		LINE_COMMENT,		// עڲ
+		BLOCK_COMMENT,		// עڲ
+		BLOCK_COMMENT_STAR	// עڲһַΪ'*'
+	};
+	// ﷨״̬һtokenӦʲô
+	enum Expect {
+		VALUE,				// һֵ
+		VALUE_OR_END,		// һֵ']'ն'['
+		KEY,				// ļն','
+		KEY_OR_END,			// ļ'}'ն'{'
+		COLON,				// ':'
+		COMMA_OR_END		// ','Ľ
+	};
+	// Frame Ϊһδ
+	struct Frame {
+		bool is_object;
+		json11::JsonArray array;
+		std::vector<json11::JsonObject::value_type> members; // Ѿļֵԣ˳
+		std::string key;	// еȴֵļ
+	};
+
+	std::string& err; // ʱ׷JsonError::message()
+	JsonError parse_error; // зĵһƫкž
+	bool has_fail; // ¼Ƿ˴
+	const int max_depth; // JsonParserͬǶײΣĬΪjson11::default_max_depth
+	LexState lex_state;
+	Expect expect;
+	bool escaped; // IN_STRING״̬£һַǷΪδת'\\'
+	std::string token; // ǰδtoken
+	std::vector<Frame> stack; // δ
+	std::deque<Json> documents; // Ѿɡδȡĵ
+	size_t offset; // Ѿֽڱλ
+	size_t token_offset; // ǰtokenĵһֽеλ
+	size_t line; // ǰʱڵк
+	size_t line_start; // еһֽеλ
+	std::string_view chunk; // feed()ڴһݣڼڵк
+
+	bool fail(JsonErrorCode code, size_t pos);
+	bool unexpected(size_t pos);
+	bool finish_token();
+	bool on_value(Json value);
+	bool on_punct(char ch, size_t pos);
+
+public:
+	explicit JsonStreamParser(std::string& err_v, int max_depth_v = json11::default_max_depth);
+
+	/* feed()
+	 *
+	 * һݣݿλñض
+	 * ʱfalse֮feed()ٽн
+	 */
+	bool feed(const char* data, size_t len);
+	bool feed(std::string_view data) { return feed(data.data(), data.size()); }
+
+	/* finish()
+	 *
+	 * ʾѾĩβֵtokenǷûнĵ
+	 */
+	bool finish();
+
+	bool has_document() const { return !documents.empty(); }
+	Json next_document();
+	bool failed() const { return has_fail; }
+	const JsonError& error() const { return parse_error; }
+};
+
+};
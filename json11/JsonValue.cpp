@@ -1,46 +1,21 @@
-#include "JsonValue.h"
+#include "Json11.h"
 #include <cmath>
 using namespace json11;
-/*
- * JsonValueӿڵĬʵ֣static ʼճԱ 
- */
-bool								JsonValue::bool_value() const					{ return false; }
-int									JsonValue::int_value() const					{ return 0; }
-double								JsonValue::number_value() const					{ return 0; }
-const std::string&					JsonValue::string_value() const					{ return json11::default_string; }
-const json11::JsonArray&			JsonValue::array_items() const					{ return json11::default_array; }
-const json11::JsonObject&			JsonValue::object_items() const					{ return json11::default_object; }
-const std::shared_ptr<JsonValue>&	JsonValue::operator[](size_t) const				{ return json11::default_null; }
-const std::shared_ptr<JsonValue>&	JsonValue::operator[](const std::string&) const	{ return json11::default_null; }
-
-/*
- *  Value<json11::JsonType, typename>ӿڵʵ 
- */
-bool						BooleanValue::bool_value() const					{ return m_value; }
-int							NumberValue::int_value() const						{ return static_cast<int>(m_value); }
-double						NumberValue::number_value() const					{ return m_value; }
-bool						NumberValue::equals(const JsonValue* other) const	{ return m_value == other->number_value(); }
-bool						NumberValue::less(const JsonValue* other) const		{ return m_value < other->number_value(); }
-const std::string&			StringValue::string_value() const					{ return m_value; }
-const json11::JsonArray&	ArrayValue::array_items() const						{ return m_value; }
-const json11::JsonObject&	ObjectValue::object_items() const					{ return m_value; }
 
 /* ArrayValue::operator[size_t i]
  * 
- * JsonValueΪJsonArrayvector<shared_ptr<JsonValue> >øýӿ
- * λishared_ptr<JsonValue>iڣ򷵻ؿ
+ * λiֵiڣ򷵻null
  */
-const std::shared_ptr<JsonValue>& ArrayValue::operator[](size_t i) const {
+const Json& ArrayValue::operator[](size_t i) const {
 	if (i >= m_value.size()) return json11::default_null;
 	else return m_value[i];
 }
 
-/* ObjectValue::operator[const string& key]
+/* ObjectValue::operator[string_view key]
  * 
- * JsonValueΪJsonObjectmap<string, shared_ptr<JsonValue> >øýӿ
- * keyӦshared_ptr<JsonValue>keyڣ򷵻ؿ
+ * keyӦֵkeyڣ򷵻null
  */
-const std::shared_ptr<JsonValue>& ObjectValue::operator[](const std::string& key) const {
+const Json& ObjectValue::operator[](std::string_view key) const {
 	auto iter = m_value.find(key);
 	if (iter == m_value.end()) {
 		return json11::default_null;
@@ -48,31 +23,99 @@ const std::shared_ptr<JsonValue>& ObjectValue::operator[](const std::string& key
 		return iter->second;
 	}
 }
-
-/* dump()
- *  
- * ǰValueеݸJsonTypeתΪstringʽӵòoutβ 
+/* ObjectValue::operator[const JsonKey& key]
+ * 
+ * operator[string_view]ͬйϣʱֱʹkeyбĹϣֵ
  */
-void NullValue::dump(std::string& out) const {
-	out += "null";
+const Json& ObjectValue::operator[](const JsonKey& key) const {
+	auto iter = m_value.find(key);
+	if (iter == m_value.end()) {
+		return json11::default_null;
+	} else {
+		return iter->second;
+	}
 }
-void BooleanValue::dump(std::string& out) const {
-	if (m_value) out += "true";
-	else out += "false";
+/* ObjectValue::get(const ObjectKey& key)
+ * 
+ * operator[]ͬkeyΪפļʱĵͬһıȽֻȽָ
+ */
+const Json& ObjectValue::get(const ObjectKey& key) const {
+	auto iter = m_value.find(key);
+	if (iter == m_value.end()) {
+		return json11::default_null;
+	} else {
+		return iter->second;
+	}
 }
-void NumberValue::dump(std::string& out) const {
-	if (std::isfinite(m_value)) {
-		char buf[32];
-		snprintf(buf, sizeof buf, "%.17g", m_value);
-		out += buf;
+
+/* ǵݹ
+ * 
+ * ĬϵʽǵݹģʱеԪأԪԼԪء
+ * Ƕײκʱᵼջͷ顢ڵʱȰֻеӽڵƶpendingУ
+ * release_all()ͷţÿڵͷǰӽڵ㶼ѱƳ˵ջʼΪ
+ * طͬеӽڵ㣨refs > 1浱ǰڵͷţԭ
+ */
+template <typename V>
+static void delete_node(JsonNode* node) {
+	V* const value = static_cast<V*>(node);
+	if (value->arena) {
+		// ڵڴarenaֻͷţarenaڽڵ֮ſܱͷ
+		const std::shared_ptr<JsonArena> arena = std::move(value->arena);
+		value->~V();
 	} else {
-		out += "null";
+		delete value;
+	}
+}
+void Json::destroy() noexcept {
+	switch (storage()) {
+	case Storage::STRING:
+		delete_node<StringValue>(node());
+		break;
+	case Storage::STRING_REF:
+		delete_node<StringRefValue>(node());
+		break;
+	case Storage::ARRAY:
+	case Storage::OBJECT: {
+		json11::JsonArray pending;
+		release_children(pending);
+		if (storage() == Storage::ARRAY) delete_node<ArrayValue>(node());
+		else delete_node<ObjectValue>(node());
+		release_all(pending);
+		break;
+	}
+	default:
+		break;
+	}
+	m_data.scalar.storage = Storage::NUL;
+}
+void Json::release_all(json11::JsonArray& pending) {
+	while (!pending.empty()) {
+		Json node = std::move(pending.back());
+		pending.pop_back();
+		node.release_children(pending);
+	}
+}
+void Json::release_children(json11::JsonArray& out) {
+	if (storage() == Storage::ARRAY) {
+		for (Json& v : static_cast<ArrayValue*>(node())->m_value) {
+			if (v.is_unique_container()) out.push_back(std::move(v));
+		}
+	} else if (storage() == Storage::OBJECT) {
+		for (auto& kv : static_cast<ObjectValue*>(node())->m_value) {
+			if (kv.second.is_unique_container()) out.push_back(std::move(kv.second));
+		}
 	}
 }
-void StringValue::dump(std::string& out) const {
+
+/* dump_string()
+ *
+ * ַvalueתJsonַʽӵoutβ
+ * ִ洢ʽַԼObjectValueļô˺
+ */
+void json11::dump_string(std::string_view value, std::string& out) {
 	out += '"';
-	for (size_t i = 0; i < m_value.size(); ++i) {
-		const char ch = m_value[i];
+	for (size_t i = 0; i < value.size(); ++i) {
+		const char ch = value[i];
 		if (ch == '\\') {
 			out += R"(\\)";
 		} else if (ch == '"') {
@@ -91,12 +134,12 @@ void StringValue::dump(std::string& out) const {
 			char buf[8];
 			snprintf(buf, sizeof buf, "\\u%04x", ch);
 			out += buf;
-		} else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(m_value[i + 1]) == 0x80
-				   && static_cast<uint8_t>(m_value[i + 2]) == 0xa8) {
+		} else if (static_cast<uint8_t>(ch) == 0xe2 && i + 2 < value.size() && static_cast<uint8_t>(value[i + 1]) == 0x80
+				   && static_cast<uint8_t>(value[i + 2]) == 0xa8) {
 			out += "\\u2028";
 			i += 2;
-		} else if (static_cast<uint8_t>(ch) == 0xe2 && static_cast<uint8_t>(m_value[i + 1]) == 0x80
-				   && static_cast<uint8_t>(m_value[i + 2]) == 0xa9) {
+		} else if (static_cast<uint8_t>(ch) == 0xe2 && i + 2 < value.size() && static_cast<uint8_t>(value[i + 1]) == 0x80
+				   && static_cast<uint8_t>(value[i + 2]) == 0xa9) {
 			out += "\\u2029";
 			i += 2;
 		} else {
@@ -105,12 +148,17 @@ void StringValue::dump(std::string& out) const {
 	}
 	out += '"';
 }
+
+/* dump()
+ *  
+ * ǰValueеݸJsonTypeתΪstringʽӵòoutβ 
+ */
 void ArrayValue::dump(std::string& out) const {
 	bool first = true;
 	out += "[";
-	for (const std::shared_ptr<JsonValue>& v : m_value) {
+	for (const Json& v : m_value) {
 		if (!first) out += ", ";
-		(*v).dump(out);
+		v.dump(out);
 		first = false;
 	}
 	out += "]";
@@ -120,14 +168,11 @@ void ObjectValue::dump(std::string& out) const {
 	out += "{";
 	for (const auto& kv : m_value) {
 		if (!first) out += ", ";
-		// ַʽôǷװԽϺãƺӰ
-		// Json11ԭһеdump(const T&, string&)ƳValue<JsonType, T>УԴ
-		const std::shared_ptr<JsonValue> key_value = std::make_shared<StringValue>(kv.first);
-		key_value->dump(out);
+		dump_string(kv.first.view(), out);
 
 		out += ": ";
 
-		(*kv.second).dump(out);
+		kv.second.dump(out);
 		first = false;
 	}
 	out += "}";
@@ -1,155 +1,123 @@
 #pragma once
 #include "json11_namespace.h"
+#include "JsonArena.h"
+#include "JsonObject.h"
+#include <atomic>
 #include <memory>
+#include <new>
+#include <string_view>
 
+// ļJson11.hJsonJsonObjectĶ֮룬ڵеJsonArrayJsonObjectҪJsonΪ
 namespace json11 {
 
-/* JsonValue ӿ
- * 
- * Jsonݵʵʴ洢JsonValueʵ
- * ˽ӿ˶ݷʺڰJsonĽӿʵ
+/* JsonNode 
+ *
+ * Jsonֻгַ顢Ҫ䣬JsonNodeУnullboolֱַ֡ӱJsonڲ
+ * ڵʹʽüJsonֻһָڵָ룬JsonʱrefsһJsonʱͷŽڵ
+ * ڵû麯Json¼Ĵ洢ͣJson::StorageֱӵöӦĺ
  */
-class JsonValue {
+class JsonNode {
 public:
-	// type() ڷصǰJsonValueӿָݵ
-	virtual json11::JsonType type() const = 0;
-	// equals() жJsonValueӿָǷͬ
-	virtual bool equals(const JsonValue* other) const = 0;
-	// less() жϵǰJsonValueӿָǷСڲotherָ
-	virtual bool less(const JsonValue* other) const = 0;
-	// dump() ڽǰJsonValueӿָstringʽڲoutĩβ
-	virtual void dump(std::string& out) const = 0;
-	// bool_value() ڷصǰJsonValueӿָBOOLݵֵ
-	virtual bool bool_value() const;
-	// int_value() ڷصǰJsonValueӿָNUMBERݵintֵ
-	virtual int int_value() const;
-	// number_value() ڷصǰJsonValueӿָNUMBERݵdoubleֵ
-	virtual double number_value() const;
-	// strig_value() ڷصǰJsonValueӿָSTRINGݵֵ
-	virtual const std::string& string_value() const;
-	// array_items() ڷصǰJsonValueӿָJsonArrayݵֵ
-	// ע⣺˴صֵΪshared_ptr<JsonValue> ָͣ
-	virtual const json11::JsonArray& array_items() const;
-	// object_items() ڷصǰJsonValueӿָObjectݵֵ
-	// ע⣺˴صֵΪshared_ptr<JsonValue> ָͣ
-	virtual const json11::JsonObject& object_items() const;
-	// opertor[size_t i] ڷصǰJsonValueӿָJsonArrayiֵ
-	virtual const std::shared_ptr<JsonValue>& operator[](size_t i) const;
-	// operator[string& key] ڷصǰJsonValueӿָJsonObjectkeyֵ
-	virtual const std::shared_ptr<JsonValue>& operator[](const std::string& key) const;
-	
-	virtual ~JsonValue() {}
+	mutable std::atomic<uint32_t> refs{ 1 }; // ָ˽ڵJson
+	std::shared_ptr<JsonArena> arena; // ARENAģʽ½ڵڵarenaֻҪڵarenaͲᱻͷţΪʱڵnew
 };
 
-/* Value<json11::JsonType, typename>
- * 
- * JsonValueӿʵĻ
- * ͨģЧؽJsonValueʵjson11::JsonTypeΧ 
- * m_valueԸ洢
- */
-template<json11::JsonType tag, typename T>
-class Value : public JsonValue {
-protected:
-	const T m_value;
-public:
-	explicit Value(const T& value) : m_value(value) {}
-	explicit Value(T&& value) : m_value(std::move(value)) {}
-	// ʵٲJsonValueĽӿڣֱӼ̳Щظʵ
-	json11::JsonType type() const override { return tag; }
-	bool equals(const JsonValue* other) const override {
-		return m_value == static_cast<const Value<tag, T>*>(other)->m_value;
-	}
-	bool less(const JsonValue* other) const override {
-		return m_value < static_cast<const Value<tag, T>*>(other)->m_value;
-	}
-};
-
-/* NullValue 
- * 
- * 洢JsonNUL
- * ȻNULʾκϢȻҪʵdump() 
- */
-class NullValue final : public Value<json11::JsonType::NUL, json11::NullStruct> {
-public:
-	NullValue() : Value({}) {}
-	void dump(std::string& out) const override;
-};
-
-/* BooleanValue 
- * 
- * 洢JsonBOOL
- */
-class BooleanValue final : public Value<json11::JsonType::BOOL, bool> {
-public:
-	explicit BooleanValue(bool value) : Value(value) {}
-	bool bool_value() const override;
-	void dump(std::string& out) const override;
-};
-
-/* NumberValue 
- * 
- * 洢JsonеNUMBER
+/* StringValue 
+ *
+ * 洢JsonгJson::short_string_capacityֽڵSTRINGݣֱַӱJsonڲ
  */
-class NumberValue final : public Value<json11::JsonType::NUMBER, double> {
+class StringValue final : public JsonNode {
 public:
-	explicit NumberValue(int value) : Value(value) {}
-	explicit NumberValue(double value) : Value(value) {}
-	double number_value() const override;
-	int int_value() const override;
-	bool equals(const JsonValue* other) const override;
-	bool less(const JsonValue* other) const override;
-	void dump(std::string& out) const override;
+	const std::string m_value;
+	explicit StringValue(const std::string& value) : m_value(value) {}
+	explicit StringValue(std::string&& value) : m_value(std::move(value)) {}
 };
 
-/* StringValue 
- * 
- * 洢JsonеSTRING
+/* StringRefValue 
+ *
+ * IN_SITUģʽ¸洢JsonвתַĳSTRING
+ * ݱƣm_viewֱָ뻺m_owner֤뻺ڽڵڼ䲻ᱻͷ
  */
-class StringValue final : public Value<json11::JsonType::STRING, std::string> {
+class StringRefValue final : public JsonNode {
 public:
-	explicit StringValue(const std::string& value) : Value(value) {}
-	explicit StringValue(std::string&& value) : Value(std::move(value)) {}
-	const std::string& string_value() const override;
-	void dump(std::string& out) const override;
+	const std::shared_ptr<const void> m_owner;
+	const std::string_view m_view;
+	StringRefValue(std::shared_ptr<const void> owner, std::string_view view) : m_owner(std::move(owner)), m_view(view) {}
 };
 
 /* ArrayValue 
- * 
+ *
  * 洢JsonеJsonArray
  */
-class ArrayValue final : public Value<json11::JsonType::ARRAY, json11::JsonArray> {
+class ArrayValue final : public JsonNode {
 public:
-	explicit ArrayValue(const json11::JsonArray& value) : Value(value) {}
-	explicit ArrayValue(json11::JsonArray&& value) : Value(std::move(value)) {}
-	const std::shared_ptr<JsonValue>& operator[](size_t i) const override;
-	const json11::JsonArray& array_items() const override;
-	void dump(std::string& out) const override;
+	json11::JsonArray m_value; // ʱƳӽڵ⣬󲻻ٱ޸
+	explicit ArrayValue(const json11::JsonArray& value) : m_value(value) {}
+	explicit ArrayValue(json11::JsonArray&& value) : m_value(std::move(value)) {}
+	const Json& operator[](size_t i) const;
+	void dump(std::string& out) const;
 };
 
 /* ObjectValue 
- * 
+ *
  * 洢JsonеJsonObject
  */
-class ObjectValue final : public Value<json11::JsonType::OBJECT, json11::JsonObject> {
+class ObjectValue final : public JsonNode {
 public:
-	explicit ObjectValue(const json11::JsonObject& value) : Value(value) {}
-	explicit ObjectValue(json11::JsonObject&& value) : Value(std::move(value)) {}
-	const std::shared_ptr<JsonValue>& operator[](const std::string& key) const override;
-	const json11::JsonObject& object_items() const override;
-	void dump(std::string& out) const override;
+	json11::JsonObject m_value; // ʱƳӽڵ⣬󲻻ٱ޸
+	// Ϊڵٱ޸ģԱ߳ͬʱȡｨ롢ɾ󱻶Ĺϣ
+	explicit ObjectValue(const json11::JsonObject& value) : m_value(value) { m_value.build_index(); }
+	explicit ObjectValue(json11::JsonObject&& value) : m_value(std::move(value)) { m_value.build_index(); }
+	const Json& operator[](std::string_view key) const;
+	const Json& operator[](const JsonKey& key) const;
+	// get() operator[]ͬkeyĵеļָͬһڴʱֻȽָ
+	const Json& get(const ObjectKey& key) const;
+	void dump(std::string& out) const;
 };
 
+inline Json::Json(const Json& other) noexcept : m_data(other.m_data) {
+	if (has_node()) node()->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline Json::~Json() {
+	if (has_node() && node()->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) destroy();
+}
+
+inline bool Json::is_unique_container() const {
+	return (storage() == Storage::ARRAY || storage() == Storage::OBJECT) && node()->refs.load(std::memory_order_relaxed) == 1;
+}
+
+// dump_string() ڽַתӵoutβַļ
+void dump_string(std::string_view value, std::string& out);
+
+/* Json::make<V>()
+ *
+ * һV͵Ľڵ㣬arenaΪʱڵarenaУARENAģʽnew
+ */
+template <typename V, typename... Args>
+Json Json::make(const std::shared_ptr<JsonArena>& arena, Args&&... args) {
+	V* node;
+	if (arena) {
+		node = ::new (arena->allocate(sizeof(V), alignof(V))) V(std::forward<Args>(args)...);
+		node->arena = arena;
+	} else {
+		node = new V(std::forward<Args>(args)...);
+	}
+	Json result;
+	result.m_data.scalar.value.node = node;
+	if constexpr (std::is_same_v<V, StringValue>) result.m_data.scalar.storage = Storage::STRING;
+	else if constexpr (std::is_same_v<V, StringRefValue>) result.m_data.scalar.storage = Storage::STRING_REF;
+	else if constexpr (std::is_same_v<V, ArrayValue>) result.m_data.scalar.storage = Storage::ARRAY;
+	else result.m_data.scalar.storage = Storage::OBJECT;
+	return result;
+}
+
 /* static ʼճԱ
- * 
- * նȻ޷洢ݣȻڼֵ
- * JsonValueӿڶԣڵʱʹֱ߲֪ýӿָͣڵtype_valueô
- * ľ̬ʼճԱڴʱЧԤִ
- * ȻЩʼճԱûԶֹˣÿԲ
+ *
+ * ֱ߲֪JsonݵͣͲķʺֵarray_items()
+ * ʱʺճԱãǱ
  */
-static const std::shared_ptr<JsonValue> default_null = std::make_shared<NullValue>();
-static const std::shared_ptr<JsonValue> default_true = std::make_shared<BooleanValue>(true);
-static const std::shared_ptr<JsonValue> default_false = std::make_shared<BooleanValue>(false);
-static const std::string default_string;
+static const Json default_null;
 static const json11::JsonArray default_array;
 static const json11::JsonObject default_object;
-};
\ No newline at end of file
+};
@@ -2,27 +2,186 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <map>
 #include <initializer_list>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <atomic>
+#include <cstdint>
 
 namespace json11 {
 
 class Json;
-class JsonValue;
 
 // ʾJson
 enum JsonType {
 	NUL, NUMBER, BOOL, STRING, ARRAY, OBJECT
 };
+// ʾJsonParserʱڵڴ䷽ʽԼѡͨ | ʹ
+// STANDARDÿڵ㣨ַ顢󣩵new
+// ARENAͬһĵнڵһJsonArenaУĵʱһͷ
+// IN_SITUĵ뻺תֱַַ뻺
+// INTERN_KEYSļȫֵJsonKeyTableפĵͬļͬһڴ
+// VALIDATE_UTF8ַΪϷUTF-8ǷʱERR_STRING_INVALID_UTF8
+enum JsonParseMode {
+	STANDARD = 0, ARENA = 1 << 0, IN_SITU = 1 << 1, INTERN_KEYS = 1 << 2, VALIDATE_UTF8 = 1 << 3
+};
+inline JsonParseMode operator| (JsonParseMode lhs, JsonParseMode rhs) {
+	return static_cast<JsonParseMode>(static_cast<int>(lhs) | static_cast<int>(rhs));
+}
+// JsonParserĬǶײΣʱʹõݹ飬ĵparse()ʱָmax_depth
+constexpr int default_max_depth = 200;
 // ˽ṹڰNULͣûʲôô
 struct NullStruct {
 	bool operator== (NullStruct) const { return true; }
 	bool operator<	(NullStruct) const { return false; }
 };
-// JsonArrayڱʾṹ
-using JsonArray = std::vector<std::shared_ptr<JsonValue>>;
-// JsonObjectڱʾṹ
-using JsonObject = std::map<std::string, std::shared_ptr<JsonValue>>;
+// JsonArrayڱʾṹԪֱӱJson16ֽڣֵȱҪ
+using JsonArray = std::vector<Json>;
+/* ObjectKey
+ *
+ * JsonObjectеļݹ󲻿޸ģС̶Ϊ16ֽ
+ * inline_capacityֽڵĶֱ̼ӱObjectKeyڲڴ棻
+ * ļڵBlockУBlocküObjectKeyʱͬһBlock
+ * JsonKeyTableפָͬͬһBlockȽʱȱȽָ룬ָͬȷ
+ * std::stringconst char*ʽ죬ҲֱǱȽϣ
+ * JsonObjectĹ졢find()÷std::map<std::string, ...>ͬJsonObject.h
+ */
+class ObjectKey {
+public:
+	static constexpr size_t inline_capacity = 15;
+private:
+	// Block ΪݣڴУreleaseɴallocate()ɣһObjectKeyʱ
+	struct Block {
+		mutable std::atomic<uint32_t> refs{ 1 };
+		void (*release)(Block*) noexcept;
+		const char* data;
+		size_t size;
+	};
+
+	/* AllocatedBlock<Alloc>
+	 *
+	 * AllocBlockһݷͷţARENAģʽ·arena˼ڼarenaᱻͷ
+	 * ڴ水AllocatedBlockĸ䣬ݷڵһAllocatedBlock֮
+	 */
+	template <typename Alloc>
+	struct AllocatedBlock final : Block {
+		[[no_unique_address]] Alloc alloc;
+
+		using BlockAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<AllocatedBlock>;
+		static size_t count(size_t size) { return 1 + (size + sizeof(AllocatedBlock) - 1) / sizeof(AllocatedBlock); }
+
+		AllocatedBlock(const Alloc& alloc_v, std::string_view str) : alloc(alloc_v) {
+			char* const chars = reinterpret_cast<char*>(this + 1);
+			std::memcpy(chars, str.data(), str.size());
+			this->release = &destroy;
+			this->data = chars;
+			this->size = str.size();
+		}
+		static void destroy(Block* block) noexcept {
+			AllocatedBlock* const self = static_cast<AllocatedBlock*>(block);
+			BlockAlloc block_alloc(self->alloc);
+			const size_t n = count(self->size);
+			self->~AllocatedBlock();
+			std::allocator_traits<BlockAlloc>::deallocate(block_alloc, self, n);
+		}
+	};
+
+	// ShortHeap ΪObjectKeyֲ֣ͷһֽڣʼУΪ̼ĳȣΪheap_tagʾ
+	static constexpr uint8_t heap_tag = 0xFF;
+	struct Short {
+		uint8_t size;
+		char chars[inline_capacity];
+	};
+	struct Heap {
+		uint8_t tag;
+		Block* block;
+	};
+	union Data {
+		Short small;
+		Heap heap;
+	};
+	Data m_data;
+
+	bool is_heap() const { return m_data.small.size == heap_tag; }
+	// make_short() ڴΪstrĶ̼strĳȲܳinline_capacity
+	static ObjectKey make_short(std::string_view str) {
+		ObjectKey key;
+		key.m_data.small.size = static_cast<uint8_t>(str.size());
+		std::memcpy(key.m_data.small.chars, str.data(), str.size());
+		return key;
+	}
+
+	// IsStringLike ΪֱObjectKeyȽϵַͣstd::stringstd::string_viewconst char*
+	template <typename T>
+	static constexpr bool IsStringLike = std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, ObjectKey>;
+public:
+	ObjectKey() noexcept : m_data{} {}
+	ObjectKey(const std::string& str) : ObjectKey(allocate(str, std::allocator<char>())) {}
+	ObjectKey(const char* str) : ObjectKey(allocate(str, std::allocator<char>())) {}
+	explicit ObjectKey(std::string_view str) : ObjectKey(allocate(str, std::allocator<char>())) {}
+
+	ObjectKey(const ObjectKey& other) noexcept : m_data(other.m_data) {
+		if (is_heap()) m_data.heap.block->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+	ObjectKey(ObjectKey&& other) noexcept : m_data(other.m_data) { other.m_data = Data{}; }
+	ObjectKey& operator= (const ObjectKey& rhs) noexcept {
+		ObjectKey(rhs).swap(*this);
+		return *this;
+	}
+	ObjectKey& operator= (ObjectKey&& rhs) noexcept {
+		ObjectKey(std::move(rhs)).swap(*this);
+		return *this;
+	}
+	~ObjectKey() {
+		if (is_heap() && m_data.heap.block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			m_data.heap.block->release(m_data.heap.block);
+		}
+	}
+	void swap(ObjectKey& other) noexcept { std::swap(m_data, other.m_data); }
+
+	/* allocate()
+	 *
+	 * allocڴ洴ΪstrļJsonParserARENAģʽarena
+	 * ̼ڴ棬alloc޹
+	 */
+	template <typename Alloc>
+	static ObjectKey allocate(std::string_view str, const Alloc& alloc) {
+		if (str.size() <= inline_capacity) return make_short(str);
+		using Allocated = AllocatedBlock<Alloc>;
+		typename Allocated::BlockAlloc block_alloc(alloc);
+		Allocated* const block = std::allocator_traits<typename Allocated::BlockAlloc>::allocate(block_alloc, Allocated::count(str.size()));
+		::new (static_cast<void*>(block)) Allocated(alloc, str);
+		ObjectKey key;
+		key.m_data.heap = Heap{ heap_tag, block };
+		return key;
+	}
+
+	// view() ؼݣ̼ݱObjectKeyڲصstring_viewֻڸObjectKeyδƶʱЧ
+	std::string_view view() const {
+		if (is_heap()) return std::string_view(m_data.heap.block->data, m_data.heap.block->size);
+		return std::string_view(m_data.small.chars, m_data.small.size);
+	}
+	std::string str() const { return std::string(view()); }
+	operator std::string_view () const { return view(); }
+	// shares() жǷָͬһڴ棨ͬһJsonKeyTableפָ̼κڴ棬Ƿfalse
+	bool shares(const ObjectKey& other) const { return is_heap() && other.is_heap() && m_data.heap.block == other.m_data.heap.block; }
+
+	friend bool operator== (const ObjectKey& lhs, const ObjectKey& rhs) {
+		return lhs.shares(rhs) || lhs.view() == rhs.view();
+	}
+	friend bool operator< (const ObjectKey& lhs, const ObjectKey& rhs) {
+		return !lhs.shares(rhs) && lhs.view() < rhs.view();
+	}
+	template <typename T, typename = std::enable_if_t<IsStringLike<T>>>
+	friend bool operator== (const ObjectKey& lhs, const T& rhs) { return lhs.view() == std::string_view(rhs); }
+	template <typename T, typename = std::enable_if_t<IsStringLike<T>>>
+	friend bool operator< (const ObjectKey& lhs, const T& rhs) { return lhs.view() < std::string_view(rhs); }
+	template <typename T, typename = std::enable_if_t<IsStringLike<T>>>
+	friend bool operator< (const T& lhs, const ObjectKey& rhs) { return std::string_view(lhs) < rhs.view(); }
+};
+// JsonObjectڱʾṹԱ˳棬JsonObject.h
+class JsonObject;
 // shapeʲôݲ
 using shape = std::initializer_list<std::pair<std::string, json11::JsonType>>;
 
@@ -1,5 +1,10 @@
 #include "Json11.h"
+#include "JsonStreamParser.h"
+#include "JsonLazy.h"
+#include "JsonRef.h"
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 using namespace std;
 using namespace json11;
@@ -72,14 +77,14 @@ null // ע
 
 void fun3() {
 	JsonArray ja{
-		make_shared<NullValue>(),
-		make_shared<BooleanValue>(true),
-		make_shared<NumberValue>(123),
-		make_shared<StringValue>("str")
+		nullptr,
+		true,
+		123,
+		"str"
 	};
 	JsonArray jaa{
-		make_shared<ArrayValue>(ja),
-		make_shared<ArrayValue>(ja),
+		ja,
+		ja,
 	};
 
 	const Json js(jaa);
@@ -91,14 +96,14 @@ void fun3() {
 
 void fun4() {
 	JsonObject jo{
-		{ "1", make_shared<NullValue>() },
-		{ "2", make_shared<BooleanValue>(true) },
-		{ "3", make_shared<NumberValue>(123) },
-		{ "4", make_shared<StringValue>("str")}
+		{ "1", nullptr },
+		{ "2", true },
+		{ "3", 123 },
+		{ "4", "str"}
 	};
 	JsonObject joo{
-		{ "1", make_shared<ObjectValue>(jo)},
-		{ "2", make_shared<ObjectValue>(jo)},
+		{ "1", jo},
+		{ "2", jo},
 	};
 
 	const Json js(joo);
@@ -137,23 +142,274 @@ void fun6() {
 	cout << js5.type() << "  " << js5.dump() << "  " << js5.string_value() << endl;
 
 	const JsonArray ja{
-		make_shared<NullValue>(),
-		make_shared<BooleanValue>(false),
-		make_shared<NumberValue>(100),
-		make_shared<StringValue>("this is a array string")
+		nullptr,
+		false,
+		100,
+		"this is a array string"
 	};
 	const Json js6(ja);
 	cout << js6.type() << "  " << js6.dump() << endl;
 
 	const JsonObject jb{
-		{ "key1" , make_shared<StringValue>("this is a object string") },
-		{ "key2" , make_shared<ArrayValue>(ja) },
-		{ "key3" , make_shared<NullValue>() }
+		{ "key1" , "this is a object string" },
+		{ "key2" , ja },
+		{ "key3" , nullptr }
 	};
 	const Json js7(jb);
 	cout << js7.type() << "  " << js7.dump() << endl;
 }
 
+void fun7() {
+	const string str = R"([null, 1, true, ["string", {"key1" : "value1", "key2" : [false]}]])";
+	string err;
+	// ARENAģʽͬһĵнڵͬһڴУjs1ʱһͷ
+	const Json js1 = Json::parse(str, err, ARENA);
+
+	cout << js1.dump() << endl;
+	cout << js1[3][1]["key1"].dump() << endl;
+}
+
+void fun8() {
+	string str = R"({"key1" : "value1", "key2" : "escaped\tvalue"})";
+	string err;
+	// IN_SITUģʽstrƶĵڲ"value1"ֱڴ棬תַ"escaped\tvalue"Իᱻ
+	const Json js1 = Json::parse(move(str), err, IN_SITU);
+
+	cout << js1.dump() << endl;
+	cout << js1["key1"].string_view_value() << endl;
+}
+
+void fun9() {
+	// ģֿյݣݿλñض
+	const vector<string> chunks = {
+		R"({"key1" : "val)",
+		R"(ue1", "key2" : [1, 2)",
+		R"(.5, tr)",
+		R"(ue]} [null)",
+		R"(] 12)",
+		R"(3)"
+	};
+
+	string err;
+	JsonStreamParser parser(err);
+	for (const string& chunk : chunks) {
+		parser.feed(chunk);
+		while (parser.has_document()) {
+			cout << "json = " << parser.next_document().dump() << endl;
+		}
+	}
+	// ĩβ123ֻʱȷѾ
+	parser.finish();
+	while (parser.has_document()) {
+		cout << "json = " << parser.next_document().dump() << endl;
+	}
+	cout << "err = " << err << endl;
+}
+
+// ֻͳĵиֵĸҪJson
+struct CountHandler {
+	size_t numbers = 0, strings = 0, objects = 0;
+
+	bool on_null() { return true; }
+	bool on_bool(bool) { return true; }
+	bool on_number(double) { ++numbers; return true; }
+	bool on_string(std::string_view) { ++strings; return true; }
+	bool on_key(std::string_view) { return true; }
+	bool on_start_array() { return true; }
+	bool on_end_array(size_t) { return true; }
+	bool on_start_object() { ++objects; return true; }
+	bool on_end_object(size_t) { return true; }
+};
+
+void fun10() {
+	const string str = R"([{"id" : 1, "name" : "a"}, {"id" : 2, "name" : "b"}, {"id" : 3.5, "name" : null}])";
+	string err;
+	CountHandler handler;
+	Json::parse_sax(str, handler, err);
+
+	cout << "numbers = " << handler.numbers << ", strings = " << handler.strings
+		 << ", objects = " << handler.objects << ", err = " << err << endl;
+}
+
+void fun11() {
+	const string str = R"({"id" : 1, "payload" : [1, 2, 3, {"big" : "subtree"}], "route" : {"service" : "billing", "region" : "eu"}})";
+	string err;
+	// operator[]ȽһмpayloadֱƥĽ֮󣩣"billing"ڶȡʱŽ
+	const JsonLazy doc = JsonLazy::parse(str, err);
+
+	cout << doc["route"]["service"].string_value() << endl;
+	cout << doc["payload"].size() << "  " << doc["payload"][3].to_json(err).dump() << endl;
+	cout << doc["missing"].exists() << "  err = " << err << endl;
+
+	// ճһtokenᱻϷֵnullzparse()ʱ1falseto_json()ʱ
+	string err1, err2;
+	const JsonLazy bad_literal = JsonLazy::parse(string_view(R"({"k": nullz})"), err1);
+	const Json bad_number = JsonLazy::parse(string_view("1false"), err2).to_json(err2);
+	cout << bad_literal.exists() << "  " << !err1.empty() << "  " << bad_number.is_null() << "  " << !err2.empty() << endl;
+}
+
+void fun12() {
+	const string str = "{\n  \"a\" : [1, 2,\n  \"b\" : 3\n}";
+	// JsonErrorֻ¼λãҪʱٵmessage()
+	JsonError error;
+	Json::parse(str, error);
+
+	cout << error.code << "  " << error.offset << "  " << error.line << ":" << error.column << endl;
+	cout << error.message() << endl;
+}
+
+void fun13() {
+	const string good = R"({"user" : "alice", "tags" : ["a", "b"]})";
+	const string bad = "{\"user\" : \"\xff\"}";
+	// validate()ֻǷϷJson
+	JsonError error;
+	cout << Json::validate(good, error) << "  " << Json::validate(bad, error) << endl;
+	cout << error.message() << endl;
+}
+
+void fun14() {
+	const string str = R"([{"customer_identifier" : 1, "customer_display_name" : "a"}, {"customer_identifier" : 2, "customer_display_name" : "b"}])";
+	string err;
+	// INTERN_KEYSģʽе"customer_identifier"JsonKeyTable::global()פͬһڴ棨ֱ̼ӱObjectKeyڲҪפ
+	const Json js1 = Json::parse(str, err, INTERN_KEYS);
+	const ObjectKey key = JsonKeyTable::global().intern("customer_display_name");
+
+	cout << js1[0].object_items().begin()->first.shares(js1[1].object_items().begin()->first) << endl;
+	// keyĵеļͬһڴ棬ʱȽָ뼴
+	cout << js1[1].get(key).dump() << endl;
+}
+
+void fun15() {
+	const string str = R"({"id" : 42, "customer" : {"id" : 7, "name" : "alice"}, "notes" : "...",
+		"items" : [{"sku" : "a", "price" : 1.5, "qty" : 2}, {"sku" : "b", "price" : 3, "qty" : 1}]})";
+	string err;
+	// ֻ⼸·ϵֵ"notes""name""sku""qty"ڽʱֱ
+	const JsonPathFilter filter{ "/id", "/customer/id", "/items/*/price" };
+	const Json js1 = Json::parse(str, filter, err);
+
+	cout << js1.dump() << endl;
+	cout << js1["items"][1]["price"].dump() << "  err = " << err << endl;
+}
+
+// docsظ֤repsΣMB/s
+template <typename Policy>
+double policy_throughput(const vector<string>& docs, int reps, bool validate_only) {
+	const auto start = chrono::steady_clock::now();
+	size_t bytes = 0;
+	for (int r = 0; r < reps; ++r) {
+		for (const string& doc : docs) {
+			JsonError error;
+			if (validate_only) Json::validate<Policy>(doc, error);
+			else Json::parse<Policy>(doc, error);
+			bytes += doc.size();
+		}
+	}
+	return bytes / chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+}
+
+void fun16() {
+	// JsonStrictPolicyעͣconsume_garbage()жע͵ļ鲻ᱻ룻JsonPermissivePolicyע͡NaNInfinity
+	JsonError error;
+	cout << Json::parse<JsonPermissivePolicy>("[1, /* c */ NaN, -Infinity]", error).dump() << "  ";
+	cout << Json::parse<JsonStrictPolicy>("[1, /* c */ 2]", error).dump() << "  " << error.message() << endl;
+
+	vector<string> docs;
+	for (int i = 0; i < 20000; ++i) {
+		docs.push_back(R"({"id" : )" + to_string(i) + R"(, "name" : "user", "tags" : ["a", "b"], "score" : 12.5,
+			"address" : {"city" : "town", "zip" : "12345"}})");
+	}
+	cout << "validate  strict: " << policy_throughput<JsonStrictPolicy>(docs, 10, true)
+		 << " MB/s  permissive: " << policy_throughput<JsonPermissivePolicy>(docs, 10, true) << " MB/s" << endl;
+	cout << "parse     strict: " << policy_throughput<JsonStrictPolicy>(docs, 10, false)
+		 << " MB/s  permissive: " << policy_throughput<JsonPermissivePolicy>(docs, 10, false) << " MB/s" << endl;
+}
+
+void fun17() {
+	const string good = R"({"title" : "ı", "escaped" : "\u00e9t\u00e9"})";
+	const string bad = "{\"title\" : \"\xe4\xb8\"}";
+	string err;
+	// VALIDATE_UTF8ģʽַɨʱһ飬ǷUTF-8StringValue
+	cout << Json::parse(good, err, VALIDATE_UTF8).dump() << endl;
+	cout << Json::parse(bad, err, VALIDATE_UTF8).dump() << "  err = " << err << endl;
+
+	// ûԵĴת壨\ud800ͬǺϷUTF-8Ե\ud83d\ude00Ϊһ4ֽڵַ
+	string surrogate_err;
+	cout << Json::parse(R"(["\ud83d\ude00"])", surrogate_err, VALIDATE_UTF8).dump() << "  "
+		 << Json::parse(R"(["\ud800"])", surrogate_err, VALIDATE_UTF8).dump() << "  err = " << surrogate_err << endl;
+}
+
+void fun18() {
+	const vector<string> lines = { R"({"id" : 1, "tags" : ["a"]})", R"({"id" : 2, "tags" : ["b", "c"]})", R"({"id" : 3, "tags" : []})" };
+	// ͬһĵݴռֻڵһνʱ䣻ARENAģʽǰһĵarenaҲ
+	JsonParserContext context;
+	string err;
+	for (const string& line : lines) {
+		const Json js = Json::parse(line, context, err, ARENA);
+		cout << js["id"].int_value() << " : " << js["tags"].array_items().size() << endl;
+	}
+}
+
+void fun19() {
+	const string str = R"({"id" : "u-1024", "status" : "active", "role" : "admin", "bio" : "a string longer than fourteen bytes"})";
+	string err;
+	// 14ֽڵַ벻15ֽڵļֱӱJsonObjectKeyڲĵֻж"bio"ֵҪڴ
+	const Json js1 = Json::parse(str, err);
+
+	cout << sizeof(Json) << "  " << sizeof(ObjectKey) << endl;
+	cout << js1["status"].string_view_value() << "  " << js1["bio"].string_view_value() << endl;
+}
+
+void fun20() {
+	// JsonObjectĳԱ˳棬÷std::mapͬdump()˳˳޹
+	JsonObject jo{ { "zone", "eu" }, { "id", 7 } };
+	jo["name"] = "alice";
+	jo.insert_or_assign("id", 8);
+	jo.erase("zone");
+
+	const Json js1(jo);
+	cout << js1.dump() << "  " << (jo.find("name") != jo.end()) << "  " << jo.count("zone") << endl;
+}
+
+void fun21() {
+	const vector<string> lines = { R"({"customer_identifier" : 1, "shipping_address" : "a"})", R"({"customer_identifier" : 2})" };
+	// JsonKeyֻһιϣ֮ÿĵвʱֱʹãjs["shipping_address"]Ҳṹstd::string
+	const JsonKey id_key("customer_identifier");
+	string err;
+	for (const string& line : lines) {
+		const Json js = Json::parse(line, err);
+		cout << js[id_key].int_value() << "  " << js["shipping_address"].dump() << endl;
+	}
+}
+
+void fun22() {
+	const string str = R"({"routes" : [{"path" : "/a", "limit" : 10}, {"path" : "/b", "limit" : null}]})";
+	string err;
+	const Json config = Json::parse(str, err);
+	// ߳ͬʱͬһĵJsonRefָֻ룬ʱ޸κι״̬
+	vector<int> totals(4);
+	vector<thread> threads;
+	for (size_t t = 0; t < totals.size(); ++t) {
+		threads.emplace_back([&config, &totals, t]() {
+			const JsonRef routes = JsonRef(config)["routes"];
+			for (size_t r = 0; r < routes.size(); ++r) totals[t] += routes[r]["limit"].int_value();
+		});
+	}
+	for (thread& t : threads) t.join();
+
+	// "limit"Ϊnull벻ڵ"timeout"ͨexists()
+	const JsonRef route = JsonRef(config)["routes"][1];
+	cout << totals[0] << "  " << route["limit"].exists() << "  " << route["timeout"].exists() << endl;
+}
+
+void fun23() {
+	// 2^53ѩ㷨ɵIDȷ棬double
+	const string str = R"({"id" : 1234567890123456789, "max" : 18446744073709551615, "ratio" : 0.5})";
+	string err;
+	const Json js = Json::parse(str, err);
+	cout << js["id"].int64_value() << "  " << js["max"].uint64_value() << "  " << js.dump() << endl;
+	cout << (js["id"] == Json(int64_t(1234567890123456789))) << "  " << (js["id"] == Json(int64_t(1234567890123456788))) << endl;
+}
+
 int main() {
 
 	fun6();